@@ -0,0 +1,64 @@
+/*
+ * File:   ADCTelemetry_main.c
+ * Name: Streaming ADC samples to a PC
+ *
+ * Based on ADC_BasicProgramMain.c. Instead of showing the top 8 bits on PORTB every
+ * 10-bit result from AN0 is sent out of the EUSART (TX on RC6) in frames of 16 samples.
+ * See telemetry_HHWardBook1.h for the frame layout. On the PC run
+ *      host/telemetryDecode /dev/ttyUSB0 500000
+ * to check the frames and see how many samples a second are arriving.
+ *
+ * Each conversion takes 15us (4 TAD to acquire and 11 to convert at 1us a TAD), so with
+ * the loop around it the ADC gives about 50000 samples a second. Even at 500000 baud the
+ * link only carries 32000, so about one frame in three does not fit in the ring buffer
+ * and is dropped. telemetryDropped counts them and the PC sees the gaps in the sequence
+ * numbers. A __delay_us(12) after each sample brings the rate under 32000.
+ *
+ * Created on October 19, 2026
+ */
+
+#include "config_HHWardBook1.h"
+#include <xc.h>
+
+#define _XTAL_FREQ 8000000          // Oscillator frequency
+#define telemetryBaud 3             // 500000 baud, the fastest at 8MHz, 32000 samples a second
+#include "telemetry_HHWardBook1.h"
+#define frameSamples 16             // Samples in each frame
+
+// Some variables
+unsigned int samples [frameSamples];
+
+// The subroutines
+
+void __interrupt() isr (void)       // The only job of the interrupt is to feed the EUSART
+{
+    telemetryInterrupt ();
+}
+
+// Main Program
+
+void main(void)
+{
+    unsigned char n;
+    OSCCON = 0x74;          // Set OSC to 8Mhz with stable output
+    PORTA = 0;
+    PORTB = 0;
+    TRISA = 0x0f;           // Set B0 to B3 of TRISA to logic '1' (inputs), set rest to logic 0' (outputs))
+    TRISB = 0x00;           // Set all PORTB to outputs
+    ADCON0 = 0x01;          // Turn ADC on and select channel 0
+    ADCON1 = 0x0E;          // Make all bits digital except RA0
+    ADCON2 = 0b00010001;    // Select left justify, 4TAD, divide OSC by 8
+    telemetrySetUp ();
+    while (1)
+    {
+        n = 0;
+        while (n < frameSamples)
+        {
+            ADCON0bits.GO_DONE = 1;             // Start ADC conversion
+            while (ADCON0bits.GO_DONE == 1);    // Do nothing until the conversion is complete
+            samples [n] = ((unsigned int) ADRESH << 2) | (ADRESL >> 6);    // Put the 10-bit result back together
+            n ++;
+        }
+        telemetrySendFrame (0, samples, frameSamples);  // The interrupt sends it while the next 16 are taken
+    }
+}
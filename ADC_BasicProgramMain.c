@@ -66,6 +66,7 @@
 // Use project enums instead of #define for ON and OFF.
 
 #include <xc.h>
+#include "pins_HHWardBook1.h"
 
 
 
@@ -83,7 +84,7 @@ void main(void)
     {
         ADCON0bits.GO_DONE = 1;     // Start ADC conversion
         while (ADCON0bits.GO_DONE == 1);    // Do nothing until the conversion is complete
-        PORTB = ADRESH;             // Write contents of ADRESH to PORTB so PORTB displays result of conversion
+        portWrite (B, ADRESH);      // Write contents of ADRESH to the PORTB latch so PORTB displays result of conversion
         
     }
 }
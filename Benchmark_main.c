@@ -0,0 +1,202 @@
+/*
+ * File:   Benchmark_main.c
+ * Name: Timing the shared subroutines and checking them against a baseline
+ *
+ * Each benchmark is timed with Timer 1 running from the instruction clock with a 1:8
+ * prescale, so one tick is 4us and the longest benchmark (about 200ms) fits in 16 bits.
+ * The result is checked against the baseline for it: a benchmark fails if it is more than
+ * benchTolerance percent worse. The results go to the LCD one at a time and out of the
+ * EUSART (TX on RC6, 9600 baud) as key=value lines so a PC can log them:
+ *
+ *      lcdBytesPerSecond=166 baseline=166 PASS
+ *      ...
+ *      failures=0
+ *
+ *      Benchmark               What is timed                                   Better
+ *      lcdBytesPerSecond       32 bytes with lcdOut (2 x 3ms wait)              higher
+ *      quickBytesPerSecond     32 bytes with lcdOutQuick (50us wait)            higher
+ *      screenUpdateUs          2 lines into the hidden page and pageShow        lower
+ *      adcSamplesPerSecond     64 conversions of AN0 waiting on GODONE          higher
+ *      adcToDisplayUs          a conversion, sprintf and the screen update      lower
+ *      delayErrorPpm           __delay_ms(100), the traffic light timing        lower
+ *
+ * benchFailures can also be watched in the simulator. The baselines are only estimates
+ * worked out from the waits in the subroutines, replace them with the figures from a good
+ * run on the board. The RAM and program memory used by each file is in the memory summary XC8
+ * prints at the end of a build, it cannot be measured from the program.
+ *
+ * Created on October 19, 2026
+ */
+
+#include "config_HHWardBook1.h"
+#include <xc.h>
+#include <stdio.h>
+
+#define _XTAL_FREQ 8000000          // Oscillator frequency for delay
+#include "lcdPages_HHWardBook1.h"
+#ifndef benchTolerance
+#define benchTolerance  10          // Percent worse than the baseline before a benchmark fails
+#endif
+#define benchCount      6
+#define benchBytes      32          // Bytes sent in each LCD benchmark
+#define benchSamples    64          // Conversions in the ADC benchmark
+#define ticksPerSecond  250000      // Timer 1 ticks of 4us
+
+// Some variables
+const char *benchNames [benchCount] =
+{
+    "lcdBytesPerSecond", "quickBytesPerSecond", "screenUpdateUs",
+    "adcSamplesPerSecond", "adcToDisplayUs", "delayErrorPpm"
+};
+const unsigned long benchBaseline [benchCount] = { 166, 14000, 6000, 50000, 10000, 100 };    // Estimated, not measured on a board
+const unsigned char benchHigherIsBetter [benchCount] = { 1, 1, 0, 1, 0, 0 };
+unsigned long benchResult [benchCount];
+unsigned char benchFailures;        // Watch this in the simulator
+char str [40];
+
+// The subroutines
+
+void putch (char info)              // printf sends its characters out of the EUSART through this
+{
+    while (!PIR1bits.TXIF);
+    TXREG = info;
+}
+
+void initializeThePic ()
+{
+    OSCCON = 0x74;          // Sets the internal oscillator to 8Mhz stable
+    PORTA = 0;
+    PORTB = 0;
+    TRISA = 0xFF;
+    TRISB = 0x00;
+    TRISC = 0x00;           // RC6 is TX
+    ADCON0 = 0b0000001;     // ADC on, channel 0 AN0
+    ADCON1 = 0b00001011;    // Bits A0 to A3 are analog rest are digital
+    ADCON2 = 0b00010001;    // Left justify 4TAD. Clock = FOSC/8 i.e. 1MHz TAD = 1us
+    T1CON = 0b10110001;     // RD16, 1:8 prescale, Timer 1 on, 4us a tick
+    SPBRG = 12;             // 9600 baud with BRGH = 0 and BRG16 = 0
+    TXSTA = 0b00100000;     // Transmit on, asynchronous
+    RCSTA = 0b10000000;     // Serial port on
+}
+
+void benchStart ()
+{
+    TMR1H = 0;              // With RD16 the high byte is written when TMR1L is written
+    TMR1L = 0;
+}
+
+unsigned int benchTicks ()          // Timer 1 ticks since benchStart
+{
+    unsigned char low;
+    low = TMR1L;
+    return ((unsigned int) TMR1H << 8) | low;
+}
+
+void lcdBenchmark ()
+{
+    unsigned char n;
+    unsigned int ticks;
+    lcdGotoXY (0, 0);               // Leaves rsLine set for data
+    benchStart ();
+    for (n = 0; n < benchBytes; n ++)
+    {
+        lcdData = 'A' + (n & 0x0F);
+        lcdOut ();
+    }
+    ticks = benchTicks ();
+    benchResult [0] = (unsigned long) benchBytes * ticksPerSecond / ticks;
+    lcdGotoXY (0, 0);
+    benchStart ();
+    for (n = 0; n < benchBytes; n ++)
+    {
+        lcdData = 'a' + (n & 0x0F);
+        lcdOutQuick ();
+    }
+    ticks = benchTicks ();
+    benchResult [1] = (unsigned long) benchBytes * ticksPerSecond / ticks;
+}
+
+void screenBenchmark ()             // Two updates so one shows page 1 and one goes back to page 0
+{
+    unsigned int ticks;
+    benchStart ();
+    pageWriteLine (hiddenPage, 0, "Screen update 1");
+    pageWriteLine (hiddenPage, 1, "Benchmark");
+    pageShow (hiddenPage);
+    pageWriteLine (hiddenPage, 0, "Screen update 2");
+    pageWriteLine (hiddenPage, 1, "Benchmark");
+    pageShow (hiddenPage);
+    ticks = benchTicks ();
+    benchResult [2] = (unsigned long) ticks * 4 / 2;
+}
+
+void adcBenchmark ()
+{
+    unsigned char n;
+    unsigned int ticks;
+    float voltage;
+    benchStart ();
+    for (n = 0; n < benchSamples; n ++)
+    {
+        ADCON0bits.GODONE = 1;
+        while (ADCON0bits.GODONE);
+    }
+    ticks = benchTicks ();
+    benchResult [3] = (unsigned long) benchSamples * ticksPerSecond / ticks;
+    benchStart ();                  // The same steps as VoltMeter_main.c from starting the ADC to the LCD
+    ADCON0bits.GODONE = 1;
+    while (ADCON0bits.GODONE);
+    voltage = ADRESH * 0.01953 + (ADRESL >> 6) * 0.0049;
+    pageWriteLine (hiddenPage, 0, "The Voltage is");
+    sprintf (str, "%.2f Volts", voltage);
+    pageWriteLine (hiddenPage, 1, str);
+    pageShow (hiddenPage);
+    ticks = benchTicks ();
+    benchResult [4] = (unsigned long) ticks * 4;
+}
+
+void delayBenchmark ()              // The traffic lights are timed with __delay_ms, check it against Timer 1
+{
+    unsigned int ticks;
+    benchStart ();
+    __delay_ms(100);
+    ticks = benchTicks ();          // 25000 ticks if it is exact
+    benchResult [5] = ticks > 25000 ? (unsigned long) (ticks - 25000) * 40 : (unsigned long) (25000 - ticks) * 40;
+}                                   // One tick in 25000 is 40ppm
+
+unsigned char benchPassed (unsigned char n)
+{
+    if (benchHigherIsBetter [n]) return benchResult [n] * 100 >= benchBaseline [n] * (100 - benchTolerance);
+    return benchResult [n] * 100 <= benchBaseline [n] * (100 + benchTolerance);
+}
+
+// Main Program
+
+void main ()
+{
+    unsigned char n;
+    initializeThePic ();
+    setUpTheLCD ();                 // Has the 32ms power on wait the LCD needs, nothing else here times it
+    lcdBenchmark ();
+    screenBenchmark ();
+    adcBenchmark ();
+    delayBenchmark ();
+    benchFailures = 0;
+    for (n = 0; n < benchCount; n ++)
+    {
+        if (!benchPassed (n)) benchFailures ++;
+        printf ("%s=%lu baseline=%lu %s\r\n", benchNames [n], benchResult [n], benchBaseline [n],
+                benchPassed (n) ? "PASS" : "FAIL");
+        pageWriteLine (hiddenPage, 0, benchNames [n]);
+        sprintf (str, "%lu %s", benchResult [n], benchPassed (n) ? "PASS" : "FAIL");
+        pageWriteLine (hiddenPage, 1, str);
+        pageShow (hiddenPage);
+        __delay_ms(2000);
+    }
+    printf ("failures=%u\r\n", benchFailures);
+    sprintf (str, "%u failed", benchFailures);
+    pageWriteLine (hiddenPage, 0, "Benchmarks done");
+    pageWriteLine (hiddenPage, 1, str);
+    pageShow (hiddenPage);
+    while (1);
+}
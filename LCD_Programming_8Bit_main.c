@@ -67,6 +67,7 @@
 // Use project enums instead of #define for ON and OFF.
 
 #include <xc.h>
+#include "pins_HHWardBook1.h"
 
 // Use some comments to try and split the program listing into different sections
 
@@ -85,9 +86,9 @@
 #define doBlink     0b00001111      // Define the binary for doBlink
 #define shiftLeft   0b00010000      // Define the binary for shiftLeft
 #define shiftRight  0b00010100      // Define the binary for shiftRight
-#define lcdPort     PORTB           // Define which PORT LCD is connected to
-#define eBit        PORTAbits.RA0   // Define which bit the LCD ebit is connected to
-#define RSpin       PORTAbits.RA1   // Define which bit the LCD RSpin is connected to
+#define lcdPort     B               // Define which PORT LCD is connected to
+#define eBit        A,0             // Define which bit the LCD ebit is connected to
+#define RSpin       A,1             // Define which bit the LCD RSpin is connected to
 
 
 // Some variables. These comments are just to split the listing into logical sections
@@ -110,16 +111,16 @@ char lcdInitialize [7] =    // Set up an array with 7 memory locations and load
 
 void lcdOut ()              // Start of lcdOut subroutine
 {
-    lcdPort = lcdInfo;      // Send info to LCD
-    eBit = 1;               // Set eBit to logic '1'
-    eBit = 0;               // Set eBit to logic ''0'. These two make the LCD aware that new information has come to its input pins
+    portWrite (lcdPort, lcdInfo);   // Send info to LCD
+    pinHigh (eBit);         // Set eBit to logic '1'
+    pinLow (eBit);          // Set eBit to logic ''0'. These two make the LCD aware that new information has come to its input pins
     __delay_ms(2);
 }
 
 void setUpTheLCD ()         
 {
     __delay_ms(33);
-    RSpin = 0;              // Set RSpin to logic 0 to tell LCD information coming is an instruction
+    pinLow (RSpin);         // Set RSpin to logic 0 to tell LCD information coming is an instruction
     n=0;                    // Set the variable n to 0 to ready next loop
     while (n < 7)
     {
@@ -127,15 +128,15 @@ void setUpTheLCD ()
         lcdOut ();                     // Call subroutine lcdOut to send instruction to LCD
         n ++;
     }
-    RSpin = 1;              // Set RSpin back to logic 1 as next information to go to LCD will most likely be data to be displayed
+    pinHigh (RSpin);        // Set RSpin back to logic 1 as next information to go to LCD will most likely be data to be displayed
 }
 
 void line2 ()               // Start of subroutine to send cursor to start of line 2 on LCD
 {
-   RSpin = 0;               // Set RSpin to logic 0 to tell LCD information coming is an instruction
+   pinLow (RSpin);          // Set RSpin to logic 0 to tell LCD information coming is an instruction
    lcdInfo = lineTwo;       // Load variable lcdInfo with instruction to go to lineTwo
    lcdOut ();               // Call lcdOut subroutine to send instruction to LCD
-   RSpin = 1;               // Set RSpin back to logic 1 as next information to go to LCD will most likely be data to be displayed
+   pinHigh (RSpin);         // Set RSpin back to logic 1 as next information to go to LCD will most likely be data to be displayed
 }
 
 void writeString (const char *words) // Subroutine that will display a whole string of characters on the display
@@ -150,12 +151,12 @@ void writeString (const char *words) // Subroutine that will display a whole str
 
 void clearTheScreen ()      // Subroutine to clear all the data from the display and send cursor back to the start of the screen
 {
-    RSpin = 0;
+    pinLow (RSpin);
     lcdInfo = clearScreen;   // Copy the data for clearScreen instruction into lcdInfo
     lcdOut ();              // Call the lcdOut subroutine to send instruction to LCD
     lcdInfo = returnHome;   // Copy the data for returnHome instruction into lcdInfo
     lcdOut ();
-    RSpin = 1;
+    pinHigh (RSpin);
 }
 
 void main ()
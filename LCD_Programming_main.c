@@ -65,6 +65,7 @@
 // Use project enums instead of #define for ON and OFF.
 
 #include <xc.h>
+#include "pins_HHWardBook1.h"
 
 // Use some comments to try and split the program listing into different sections
 
@@ -82,9 +83,9 @@
 #define doBlink     0b00001111      // Turns the cursor on and makes it blink
 #define shiftLeft   0b00010000      // Shifts cursor one position to the left
 #define shiftRight  0b00010100      // Shifts cursor one position to the right
-#define lcdPort     PORTB           // Sets connection port for LCD
-#define eBit        PORTBbits.RB5   // Sets the bit for the E pin on the LCD
-#define rspin       PORTBbits.RB4   // Sets the bit for the RS pin on the LCD
+#define lcdPort     B               // Sets connection port for LCD
+#define eBit        B,5             // Sets the bit for the E pin on the LCD
+#define rspin       B,4             // Sets the bit for the RS pin on the LCD
 
 // Some variables. These comments are just to split the listing into logical sections
 
@@ -111,9 +112,9 @@ void sendInfo ()            // Subroutine to send info to the lcd
                                     // b4, b5, b6 and b7 will always be logic '0' and loads the result into lcdInfo
     lcdInfo = lcdInfo | rsOr;       // Performs a logical OR with lcdInfo and rs0r. 
                                     // Allows us to determine if the info is an instruction or data set
-    lcdPort = lcdInfo;              // Sends the info to the LCD
-    eBit = 1;                       // Tells the driver that new info has arrived at the lcd
-    eBit = 0;
+    portWrite (lcdPort, lcdInfo);   // Sends the info to the LCD
+    pinHigh (eBit);                 // Tells the driver that new info has arrived at the lcd
+    pinLow (eBit);
     __delay_ms(2);
 }                                   // Closing bracket for sendInfo subroutine
 
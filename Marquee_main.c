@@ -0,0 +1,43 @@
+/*
+ * File:   Marquee_main.c
+ * Name: Scrolling message on the LCD
+ *
+ * Writes a message that is too long for the 16 character LCD into the DDRAM once
+ * and then scrolls it with the display shift instruction, one byte per step.
+ * See lcdMarquee_HHWardBook1.h.
+ *
+ * Created on October 19, 2026
+ */
+
+#include "config_HHWardBook1.h"
+#include <xc.h>
+
+// Some definitions
+#define _XTAL_FREQ 8000000          // Oscillator frequency for delay
+#include "lcdMarquee_HHWardBook1.h"
+
+// Main Program
+
+void main ()
+{
+    PORTA = 0;
+    PORTB = 0;
+    PORTC = 0;
+    PORTD = 0;
+    TRISA = 0xFF;
+    TRISB = 0x00;               // The LCD is on PORTB
+    TRISC = 0x00;
+    TRISD = 0x00;
+    ADCON0 = 0x00;              // Turns off ADC
+    ADCON1 = 0x0F;              // Sets all bits to digital mode
+    OSCTUNE = 0x00;
+    OSCCON = 0x74;              // Sets the internal oscillator to 8Mhz stable
+    T0CON = 0xC7;               // Turns timer 0 on, 8-bit with the maximum divide rate so it overflows every 32.8ms
+    setUpTheLCD ();
+    marqueeStart ("C Programming for the PIC Micro", 0, 10);               // Scroll every 10 overflows i.e. 328ms
+    marqueeStart ("     H.H. Ward      H.H. Ward", 1, 10);                 // Line 2 moves with line 1 so fill it as well
+    while (1)
+    {
+        marqueeTick ();         // One byte to the LCD every scroll step, the rest of the time is free
+    }
+}
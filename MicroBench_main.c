@@ -0,0 +1,192 @@
+/*
+ * File:   MicroBench_main.c
+ * Name: How many instruction cycles the C in SampleProgramDebugging_main.c costs
+ *
+ * Each kernel is one of the operations from SampleProgramDebugging_main.c, or a second
+ * way of writing the same thing, run kernelRuns times in a loop. Timer 1 counts every
+ * instruction cycle (0.5us at 8MHz). The time of the same loop with nothing in it is
+ * taken off, and what is left divided by kernelRuns is the cost of one operation, which
+ * goes into kernelCycles. Run it on the board or in the MPLAB X simulator and watch
+ * kernelCycles, or stop on the while (1) at the end.
+ *
+ *      Kernel              Operation                                   Compare with
+ *      0  add8             number1 = number1 + 2   (unsigned char)     1
+ *      1  add16            y = y + 2               (int)               0
+ *      2  shift16          z = y << 1                                  3
+ *      3  shift8           a = a << 1
+ *      4  castFloat        t = (unsigned char) u
+ *      5  ternary          y = (a > 0) ? a : -1                        6
+ *      6  ifElse           if (a > 0) y = a; else y = -1;              5
+ *      7  bitTest          if (n & 0b00001000) m = 5; else m = 3;
+ *      8  pointerFill      listpointer = list; *listpointer = n; listpointer ++;    9
+ *      9  indexFill        b = 0; list [b] = n; b ++;                  8
+ *      10 intCounter       for (y = 0; y < 5; y ++) list [y] = n;      11
+ *      11 charCounter      for (b = 0; b < 5; b ++) list [b] = n;      10
+ *      12 floatMultiply    u = 2.55; u = u * 1.5                       13
+ *      13 fixedMultiply    q = 0x0280; q = (long) q * 384 >> 8         12
+ *                          (Q8.8, 2.5 = 0x0280 and 1.5 = 384)
+ *      14 mul16            w = mul16 (ua, ub)  (fixedMath_HHWardBook1.h)       15
+ *      15 mulLibrary       w = (unsigned long) ua * ub                     14
+ *      16 divideBy         uc = divideBy (ua, 10, fixedReciprocal (10))    17
+ *      17 divideLibrary    uc = ua / 10                                    16
+ *
+ * Kernels 8, 9, 12 and 13 set their start value again each time so the result does not
+ * run off the end of list or overflow, and the pairs include the same extra work. The two
+ * counter kernels fill 5 elements so their result is for the whole loop.
+ *
+ * The variables are volatile so the compiler cannot leave the operation out of the loop.
+ *
+ * PC build: with PIN_HOST_BACKEND each kernel is timed with the PC's clock instead of
+ * Timer 1, as the PC build of Timer 1 (host/xc.h) counts register accesses and delays but
+ * not the C in between, so every kernel would be 0. It prints one name=ns line a kernel:
+ *      gcc -O2 -DPIN_HOST_BACKEND -Ihost -o microBench MicroBench_main.c host/pinsVcd.c -lm
+ *      PINS_VCD=/dev/null ./microBench
+ *
+ * Results, nanoseconds an operation, the middle of 5 runs of the PC build (gcc 12 -O2 on
+ * an Intel Xeon, runs differ by up to 20%):
+ *
+ *      add8            2.92        pointerFill     3.11        floatMultiply   0.78
+ *      add16           2.95        indexFill       1.58        fixedMultiply   1.03
+ *      shift16         1.32        intCounter      8.90        mul16           3.00
+ *      shift8          2.83        charCounter     11.16       mulLibrary      0.79
+ *      castFloat       0.77                                    divideBy        4.12
+ *      ternary         0.90                                    divideLibrary   0.80
+ *      ifElse          0.80
+ *      bitTest         0.74
+ *
+ * What they show, on the PC only:
+ *      pointer against index   the index is twice as quick, the volatile pointer has to
+ *                              be stored and read back every time
+ *      char against int        the int counter is a little quicker, 32 bits is the PC's
+ *                              own size and the char needs widening to index list
+ *      float against fixed     the same within the noise, the PC multiplies floats in
+ *                              hardware, and its own * and / beat mul16 and divideBy
+ *
+ * None of that carries over to the PIC, an 8-bit core with no floating point where int is
+ * 16 bits and every float operation is a library call. The PIC figures have to come from
+ * kernelCycles on the board or in the MPLAB X simulator.
+ *
+ * Created on October 19, 2026
+ */
+
+#include "config_HHWardBook1.h"
+#include <xc.h>
+#include "fixedMath_HHWardBook1.h"
+
+#define kernelCount     18
+#ifdef PIN_HOST_BACKEND
+#include <stdio.h>
+#include <time.h>
+#define kernelRuns      10000000UL  // The PC's clock is coarse next to one operation, so many more
+#define countType       unsigned long
+#else
+#define kernelRuns      64          // Times each kernel is run, small enough for the float ones to fit in 16 bits
+#define countType       unsigned char
+#endif
+
+// Some variables
+volatile unsigned char number1 = 0x0F, t, m, a, n, b;  // The same variables as SampleProgramDebugging_main.c
+volatile int y = 2, z;
+volatile float u = 2.55;
+volatile int q = 0x0280;            // 2.5 in Q8.8, 8 bits of whole number and 8 bits of fraction
+volatile unsigned int ua = 51234, ub = 43210, uc;
+volatile unsigned long w;
+unsigned char list [5];
+unsigned char * volatile listpointer;
+unsigned int emptyLoop;             // Cycles for the loop with no kernel in it, nanoseconds in the PC build
+unsigned int kernelCycles [kernelCount];   // The results, cycles for one operation, picoseconds in the PC build
+countType count;
+
+// Times the code kernelRuns times and stores the cycles for one run in kernelCycles [id]
+#define kernel(id, code) \
+    benchStart (); \
+    for (count = 0; count < kernelRuns; count ++) { code; } \
+    kernelCycles [id] = benchResult (benchTicks ())
+
+// The subroutines
+
+#ifdef PIN_HOST_BACKEND
+
+const char *kernelNames [kernelCount] = {"add8", "add16", "shift16", "shift8", "castFloat", "ternary", "ifElse", "bitTest",
+    "pointerFill", "indexFill", "intCounter", "charCounter", "floatMultiply", "fixedMultiply", "mul16", "mulLibrary",
+    "divideBy", "divideLibrary"};
+unsigned long long benchStartNs;
+
+unsigned long long benchNs ()       // The PC's clock
+{
+    struct timespec now;
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+void benchStart ()
+{
+    benchStartNs = benchNs ();
+}
+
+unsigned long benchTicks ()         // Nanoseconds since benchStart
+{
+    return benchNs () - benchStartNs;
+}
+
+unsigned int benchResult (unsigned long ticks)  // Picoseconds for one operation, 0 if it was quicker than the empty loop
+{
+    return ticks > emptyLoop ? (ticks - emptyLoop) * 1000ULL / kernelRuns : 0;
+}
+
+#else
+
+void benchStart ()
+{
+    TMR1H = 0;              // With RD16 the high byte is written when TMR1L is written
+    TMR1L = 0;
+}
+
+unsigned int benchTicks ()          // Instruction cycles since benchStart
+{
+    unsigned char low;
+    low = TMR1L;
+    return ((unsigned int) TMR1H << 8) | low;
+}
+
+#define benchResult(ticks)  (((ticks) - emptyLoop) / kernelRuns)
+
+#endif
+
+// Main Program
+
+void main ()
+{
+    OSCCON = 0x74;          // Set OSC to 8Mhz with stable output
+    T1CON = 0b10000001;     // RD16, 1:1 prescale, Timer 1 on so it counts instruction cycles
+    emptyLoop = 0;
+    benchStart ();
+    for (count = 0; count < kernelRuns; count ++);
+    emptyLoop = benchTicks ();
+
+    kernel (0, number1 = number1 + 2);
+    kernel (1, y = y + 2);
+    y = 7;
+    kernel (2, z = y << 1);
+    kernel (3, a = a << 1);
+    kernel (4, t = (unsigned char) u);
+    a = 0b00010011;
+    kernel (5, y = (a > 0) ? a : -1);
+    kernel (6, if (a > 0) y = a; else y = -1);
+    n = 0b00001000;
+    kernel (7, if (n & 0b00001000) m = 5; else m = 3);
+    kernel (8, listpointer = list; *listpointer = n; listpointer ++);
+    kernel (9, b = 0; list [b] = n; b ++);
+    kernel (10, for (y = 0; y < 5; y ++) list [y] = n);
+    kernel (11, for (b = 0; b < 5; b ++) list [b] = n);
+    kernel (12, u = 2.55; u = u * 1.5);
+    kernel (13, q = 0x0280; q = (long) q * 384 >> 8);
+    kernel (14, w = mul16 (ua, ub));
+    kernel (15, w = (unsigned long) ua * ub);
+    kernel (16, uc = divideBy (ua, 10, fixedReciprocal (10)));
+    kernel (17, uc = ua / 10);
+#ifdef PIN_HOST_BACKEND
+    for (count = 0; count < kernelCount; count ++) printf ("%s=%.3f\n", kernelNames [count], kernelCycles [count] / 1000.0);
+#endif
+    while (1);              // Stop here and look at kernelCycles
+}
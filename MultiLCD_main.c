@@ -0,0 +1,80 @@
+/*
+ * File:   MultiLCD_main.c
+ * Name: Two LCDs on one shared bus
+ *
+ * Both LCDs are connected to RB0 to RB4 (D4 to D7 and RS). The E pin of LCD 0 is on RD0
+ * and the E pin of LCD 1 is on RD1. See lcdMulti_HHWardBook1.h.
+ *
+ * The program fills one LCD and then both LCDs and measures how long each took with
+ * Timer 1. The bytes per second for each are then shown on LCD 0. Because the bytes to
+ * the two LCDs are interleaved the second figure should be close to double the first.
+ * The same figures can be read from the variables oneRate and twoRate in the watch
+ * window when the program is run in the MPLAB X simulator.
+ *
+ * Created on October 19, 2026
+ */
+
+#include "config_HHWardBook1.h"
+#include <xc.h>
+#include <stdio.h>
+
+// Some definitions
+#define _XTAL_FREQ 8000000          // Oscillator frequency for delay
+#define lcdDisplays 2               // Two LCDs on the bus
+#include "lcdMulti_HHWardBook1.h"
+
+// Some variables
+char str[17];
+unsigned long oneRate, twoRate;     // Bytes per second to one LCD and to two LCDs
+
+// The subroutines
+
+unsigned long fillDisplays (unsigned char displays)    // Fills the first 'displays' LCDs and returns the bytes per second
+{
+    unsigned char display;
+    unsigned int start, ticks;
+    unsigned long sent;
+    start = lcdMultiNow ();
+    sent = lcdBytesSent;
+    display = 0;
+    while (display < displays)
+    {
+        lcdMultiGoto (display, 0, 0);
+        lcdMultiWriteString (display, "0123456789ABCDEF");
+        lcdMultiGoto (display, 0, 1);
+        lcdMultiWriteString (display, "FEDCBA9876543210");
+        display ++;
+    }
+    while (lcdMultiBusy ()) lcdMultiService ();    // Keep sending until every queue is empty
+    ticks = lcdMultiNow () - start;                 // Timer 1 ticks are 0.5us so 2000000 ticks is one second
+    return (lcdBytesSent - sent) * 2000000 / ticks;
+}
+
+// Main Program
+
+void main ()
+{
+    PORTA = 0;
+    PORTB = 0;
+    PORTC = 0;
+    PORTD = 0;
+    TRISA = 0xFF;
+    TRISB = 0x00;               // The shared LCD bus
+    TRISC = 0x00;
+    TRISD = 0x00;               // The E pins
+    ADCON0 = 0x00;              // Turns off ADC
+    ADCON1 = 0x0F;              // Sets all bits to digital mode
+    OSCTUNE = 0x00;
+    OSCCON = 0x74;              // Sets the internal oscillator to 8Mhz stable
+    lcdMultiSetUp ();           // Sets up both LCDs together
+    oneRate = fillDisplays (1);
+    twoRate = fillDisplays (2);
+    lcdMultiClear (0);
+    sprintf (str, "1 LCD %lu B/s", oneRate);
+    lcdMultiWriteString (0, str);
+    lcdMultiGoto (0, 0, 1);
+    sprintf (str, "2 LCD %lu B/s", twoRate);
+    lcdMultiWriteString (0, str);
+    while (lcdMultiBusy ()) lcdMultiService ();
+    while (1);
+}
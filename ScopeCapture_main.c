@@ -0,0 +1,101 @@
+/*
+ * File:   ScopeCapture_main.c
+ * Name: Scope mode for the voltage on AN0
+ *
+ * Captures 1600 samples of AN0 at 40000 samples a second around a rising edge through
+ * 2.5V, with a quarter of them before the trigger. See scopeCapture_HHWardBook1.h.
+ * When the capture has frozen it is sent out of the EUSART in telemetry frames
+ * (channel 0x80) for host/telemetryDecode and can then be paged through on the LCD,
+ * two samples at a time, with the button on RA4. After the last sample it captures again.
+ *
+ * Created on October 19, 2026
+ */
+
+#include "config_HHWardBook1.h"
+#include <xc.h>
+#include <stdio.h>
+
+// Some definitions
+#define _XTAL_FREQ 8000000          // Oscillator frequency for delay
+#define telemetryBaud 3             // 500000 baud
+#include "lcd4Bit_HHWardBook1.h"
+#include "telemetry_HHWardBook1.h"
+#include "scopeCapture_HHWardBook1.h"
+#define pageButton A,4              // Shows the next two samples
+#define triggerLevel 128            // 2.5V in the top 8 bits of the ADC
+#define samplePeriod 50             // 50 x 0.5us = 25us, 40000 samples a second
+
+// Some variables
+char str[17];
+unsigned int frame [16];
+
+// The subroutines
+
+void __interrupt() isr (void)
+{
+    scopeInterrupt ();
+    telemetryInterrupt ();
+}
+
+void sendCapture ()                 // Sends the whole capture to the PC, waiting for room so no frame is dropped
+{
+    unsigned int index;
+    unsigned char n;
+    index = 0;
+    while (index < scopeDepth)
+    {
+        n = 0;
+        while (n < 16)
+        {
+            frame [n] = scopeSample (index);
+            index ++;
+            n ++;
+        }
+        while (telemetryRoom () < 25);  // A frame of 16 samples is 25 bytes
+        telemetrySendFrame (0x80, frame, 16);
+    }
+}
+
+void showSample (unsigned int index)    // Shows one sample, numbered from the trigger, on the line the cursor is on
+{
+    sprintf (str, "%+5d %4u", (int) (index - scopeTrigger), scopeSample (index));
+    writeString (str);
+}
+
+// Main Program
+
+void main ()
+{
+    unsigned int index;
+    OSCCON = 0x74;              // Sets the internal oscillator to 8Mhz stable
+    PORTA = 0;
+    PORTB = 0;
+    PORTC = 0;
+    TRISA = 0xFF;
+    TRISB = 0x00;               // The LCD is on PORTB
+    ADCON0 = 0x01;              // ADC on, channel 0 AN0
+    ADCON1 = 0b00001011;        // Bits A0 to A3 are analog rest are digital
+    setUpTheLCD ();
+    telemetrySetUp ();
+    while (1)
+    {
+        clearTheScreen ();
+        writeString ("Armed");
+        scopeArm (triggerLevel, risingEdge, 25, samplePeriod);
+        while (scopeState != scopeFrozen);  // The interrupt does all the work
+        clearTheScreen ();
+        writeString ("Sending");
+        sendCapture ();
+        index = 0;
+        while (index < scopeDepth)
+        {
+            clearTheScreen ();
+            showSample (index);
+            line2 ();
+            showSample (index + 1);
+            while (!pinRead (pageButton));  // Wait for the button to be pressed
+            while (pinRead (pageButton));   // and let go
+            index += 2;
+        }
+    }
+}
@@ -15,6 +15,7 @@
 
 #include "config_HHWardBook1.h"
 #include <xc.h>
+#include "pins_HHWardBook1.h"
 #include <stdio.h>
 
 // Some definitions
@@ -31,8 +32,8 @@
 #define doBlink 0b00001111          // Turns the cursor on and makes it blink
 #define shiftLeft   0b00010000      // Shifts the cursor one position to the left
 #define shiftRight  0b00010100      // Shifts the cursor one position to the right
-#define lcdPort PORTB               // Sets which port the LCD is connected to
-#define eBit PORTBbits.RB5          // Sets the bit for the E pin on the LCD
+#define lcdPort B                   // Sets which port the LCD is connected to
+#define eBit B,5                    // Sets the bit for the E pin on the LCD
 #define startButton PORTAbits.RA0   // Tells compiler the waitbutton is on bit0 of PortA
 
 // Some variables
@@ -58,9 +59,9 @@ void sendData ()
     lcdTempData = (lcdTempData << 4 | lcdTempData >> 4);    // Swaps the nibbles around in lcdTempData ready to send to the LCD
     lcdData = lcdTempData & 0x0F;                           // Basically ignores the last four bits of the lcdTempData
     lcdData = lcdData | rsLine;                             // Allows us to determine if the info is an instruction or data
-    lcdPort = lcdData;                                      // Send the info to the LCD
-    eBit = 1;                                               // Next two instructions are to tell the LCD new data has arrived and it should deal with it
-    eBit = 0;
+    portWrite (lcdPort, lcdData);                           // Send the info to the LCD
+    pinHigh (eBit);                                         // Next two instructions are to tell the LCD new data has arrived and it should deal with it
+    pinLow (eBit);
     __delay_ms(3);           
 }
 
@@ -69,32 +69,42 @@
 
 // Some definitions
 #define _XTAL_FREQ 8000000          // Oscillator frequency for delay
-#define firstbyte 0b00110011
-#define secondbyte 0b00110011
-#define fourBitOp   0b00110010      // Sets LCD for 4-bit operation instead of 8
-#define twoLines    0b00101100      // Sets the LCD to 2 line mode
-#define incPosition 0b00000110      // Tells the LCD to increment the cursor position after any data is displayed
-#define cursorNoBlink   0b00001100  // Turns the cursor off so we don't see it flashing
-#define clearScreen 0b00000001      // Clears the screen of all display
-#define returnHome  0b00000010      // Sends the cursor back to the start position on the display
-#define lineTwo 0b11000000          // Sends the cursor to the start of line 2 on the display
-#define doBlink 0b00001111          // Turns the cursor on and makes it blink
-#define shiftLeft   0b00010000      // Shifts the cursor one position to the left
-#define shiftRight  0b00010100      // Shifts the cursor one position to the right
-#define lcdPort PORTB               // Sets which port the LCD is connected to
-#define eBit    PORTBbits.RB5       // Sets the bit for the E pin on the LCD
-#define rspin   PORTBbits.RB4       // Sets the bit for the RS pin on the LCD
+#include "lcdPages_HHWardBook1.h"   // The LCD subroutines, they need _XTAL_FREQ so it is included after it
+#include "lcdBar_HHWardBook1.h"     // The bar graph view
+#define logRecords 127                 // The last 8 bytes of the EEPROM are left for the ADC setting
+#include "eepromLog_HHWardBook1.h"  // A record of min, max and mean about once a minute, kept through switch off
+#include "adcTiming_HHWardBook1.h"  // Finds the fastest ADC timing that still reads AN0 well
+#include "freqMeter_HHWardBook1.h"  // Frequency and duty of the signal on RC2/CCP1
+#define viewButton A,4              // The button on RA4 steps through the voltage, min/max, history, bar and frequency views
+                                    // Held at switch on it has adcCalibrate find the ADC setting again
+#define voltageView 0
+#define statsView   1
+#define historyView 2               // The newest record in the EEPROM log
+#define barView     3               // The voltage as text and as an 80 step bar
+#define freqView    4               // Frequency, period and duty cycle on RC2
+#define dumpButton A,5              // With PROFILE defined, the button on RA5 shows the profile results, with TRACE it sends the trace
+#define lcdPowerOnTicks 8000        // 32ms in timer 0 ticks of 4us, the LCD needs this long after power on
+#ifndef adcSetting
+#define adcSetting 0b00010001       // ADCON2, can be set on the command line to try other TAD and acquisition times
+#define adcCalibrateOnce            // Only when it is not set, so a given setting is the one measured
+#endif
+#define adcSettingAddress 1016      // ADCON2 from adcCalibrate and its complement, in the EEPROM after the log
 
 // Some variables
-unsigned char lcdData, lcdTempData, rsLine;
-unsigned char n;
 char str[80];
 float sysVoltage;
+unsigned int adcReading;                    // The 10-bit result the voltage was worked out from
+float minVoltage = 99.0, maxVoltage = 0.0;   // Lowest and highest voltage seen since switch on
+unsigned char view, lastButton;             // Which view is showing and the button level last time round the loop
+unsigned char barReadings;                  // Readings since the text of the bar view was written
+unsigned int bootTicks;                     // Timer 0 ticks (4us) from reset to the first reading on the LCD, watch it in the simulator
 
 // The subroutines
 
 void initializeThePic ()
 {
+    OSCCON = 0x74;          // Sets the internal oscillator to 8Mhz stable. First so the rest of the set up runs 8 times faster than at 1MHz
+    T0CON = 0b10000010;     // Timer 0 on, 16-bit, 1:8 so it counts 4us ticks from reset. Used to time the LCD power on wait
     PORTA = 0;
     PORTB = 0;
     PORTC = 0;
@@ -105,121 +115,202 @@ void initializeThePic ()
     TRISD = 0x00;
     ADCON0 = 0b0000001;     // Bit 0 = '1' means ADC bits 5,5,3,2 = '0' means channel 0 AN0 is selected
     ADCON1 = 0b00001011;    // Bits A0 to A3 are analog rest are digital
-    ADCON2 = 0b00010001;    // Select left justify 4TAD. Clock = FOSC/8 i.e. 1MHz TAD = 1us
+    ADCON2 = adcSetting;    // Select left justify 4TAD. Clock = FOSC/8 i.e. 1MHz TAD = 1us
     OSCTUNE = 0x00;
-    OSCCON = 0x74;          // Sets the internal oscillator to 8Mhz stable
-    T0CON = 0xC7;           // Turns timer 0 on, makes it an 8-bit timer with the maximum divide rate
 }
 
-char lcdInitialize [8] =    // Creates an array of 8 locations long and loads each location with the following data
+void adcSettingSetUp ()         // The ADCON2 kept in the EEPROM, found again with adcCalibrate if there is none or the view button is held
 {
-    firstbyte,
-    secondbyte,
-    fourBitOp,
-    twoLines,
-    incPosition,
-    cursorNoBlink,
-    clearScreen,
-    returnHome,
-};
-
-void sendData ()
+    unsigned char setting;
+    setting = logRead (adcSettingAddress);
+    if (!pinRead (viewButton) && logRead (adcSettingAddress + 1) == (unsigned char) ~setting)
+    {
+        ADCON2 = setting;
+        return;
+    }
+    setting = adcCalibrate (0);     // About 80ms, the best ADCON2 is left in place and AN0 selected
+    logWriteByte (adcSettingAddress, setting);      // About 8ms more, only this once
+    logWriteByte (adcSettingAddress + 1, ~setting);
+}
+
+unsigned int timeSinceReset ()  // Reads timer 0, the low byte must be read first as that copies the high byte into TMR0H
 {
-    lcdTempData = (lcdTempData << 4 | lcdTempData >> 4);    // Swaps the nibbles around in lcdTempData ready to send to the LCD
-    lcdData = lcdTempData & 0x0F;                           // Basically ignores the last four bits of the lcdTempData
-    lcdData = lcdData | rsLine;                             // Allows us to determine if the info is an instruction or data
-    lcdPort = lcdData;                                      // Send the info to the LCD
-    eBit = 1;                                               // Next two instructions are to tell the LCD new data has arrived and it should deal with it
-    eBit = 0;
-    __delay_ms(3);           
+    unsigned char low;
+    low = TMR0L;
+    return ((unsigned int) TMR0H << 8) | low;
 }
 
-void lcdOut ()
+void systemVoltage ()           // Starts a conversion and stores the result into a variable called sysVoltage. 
+                                // Note: systemVoltage must be of type float as it will be a decimal number
 {
-    lcdTempData = lcdData;      // Store the information in a temporary location
-    sendData ();                // Sends the high nibble of the information to the LCD
-    sendData ();                // Sends the low nibble of the information to the LCD
+    profileEnter (probeSystemVoltage);
+    ADCON0bits.GODONE = 1;                                      // Starts the ADC conversion by setting bit 1 of ADCON0
+    while (ADCON0bits.GODONE);                                  // Waits for bit 1 of the ADCON0 register to go to logic '0'. 
+                                                                // This happens automatically when the conversion ends
+    traceEvent (traceAdcDone, ADRESH);
+    sysVoltage = (ADRESH*0.01953 + (ADRESL >> 6) * 0.0049);     // Converts the binary value from the ADC to the actual voltage
+    adcReading = ((unsigned int) ADRESH << 2) | (ADRESL >> 6);
+    profileExit (probeSystemVoltage);
 }
 
-void setUpTheLCD ()
+void displayVoltage (float dp)      // Creates a subroutine to write the voltage view into the hidden page of the LCD
 {
-    __delay_ms(32);
-    n=0;                        // Makes variable n = 0 ready for the while loop upcoming
-    rsLine = 0x00;              // Ensures bit-4 or the RS pin will be logic '0' as these are instructions
-    while (n <8)
-    {
-        lcdData = lcdInitialize [n];    // Load the variable lcdData with particular contents of the memory location in the array 
-                                        // lcdInitiazlize the pointer is currently pointing to
-        lcdOut ();                      // Send that information to the LCD
-        n ++;  
-    }
-    rsLine = 0x10;                      // Ensures bit-4 of the rsLine is a logic 1 for data
+    pageWriteLine (hiddenPage, 0, "The Voltage is");
+    profileEnter (probeSprintf);
+    sprintf(str, "%.2f Volts", dp); // This use of the function sprintf to display the floating point value using 2 decimal points
+    profileExit (probeSprintf);
+    pageWriteLine (hiddenPage, 1, str);
 }
 
-void line2 ()
+void displayStats ()                // Writes the min/max view into the hidden page of the LCD
 {
-    rsLine = 0x00;                      // Ensures bit 4 or the RS pin will be logic 0 as these are instructions
-    lcdData = lineTwo;
-    lcdOut ();
-    rsLine = 0x10;                      // Ensures bit 4 of the rsLine is a logic 1 for data
+    sprintf(str, "Min %.2f Volts", minVoltage);
+    pageWriteLine (hiddenPage, 0, str);
+    sprintf(str, "Max %.2f Volts", maxVoltage);
+    pageWriteLine (hiddenPage, 1, str);
 }
 
-void clearTheScreen ()
+void displayHistory ()              // Writes the newest EEPROM log record into the hidden page of the LCD
 {
-    rsLine = 0x00;                      // Ensures bit 4 or the RS pin will be logic 0 as these are instructions
-    lcdData = clearScreen;              // Loads the variable lcdData with the instruction to clear the screen
-    lcdOut ();                          // Sends the instruction to the LCD
-    lcdData = returnHome;               // Loads the variable lcdData with the instruction to return the cursor to the home position
-    lcdOut ();                          // Sends the instruction to the LCD
-    rsLine = 0x10;                      // Ensures bit 4 of the rsLine is a logic 1 for data
+    if (!logValid)
+    {
+        pageWriteLine (hiddenPage, 0, "No history yet");
+        pageWriteLine (hiddenPage, 1, "");
+        return;
+    }
+    sprintf(str, "Mean %.2f Volts", logLastMean * 0.0049);
+    pageWriteLine (hiddenPage, 0, str);
+    sprintf(str, "%.2f to %.2f", logLastMin * 0.0049, logLastMax * 0.0049);
+    pageWriteLine (hiddenPage, 1, str);
 }
 
-void gohome ()
+void displayBar ()                  // Writes straight into the page that is showing so only the end of the bar has to change
 {
-    rsLine = 0x00;                      // Ensures bit 4 or the RS pin will be logic 0 as these are instructions
-    lcdData = returnHome;               // Loads the variable lcdData with the instruction to return the cursor to the home position
-    lcdOut ();                          // Sends the instruction to the LCD
-    rsLine = 0x10;                      // Ensures bit 4 of the rsLine is a logic 1 for data
+    if (!(barReadings & 0x0F))      // sprintf is slow so the text is only written every 16 readings, the bar every reading
+    {
+        sprintf(str, "%.2f Volts", sysVoltage);
+        pageWriteLine (visiblePage, 0, str);
+    }
+    barReadings ++;
+    barShow ((adcReading * 5 + 32) >> 6, lcdRowStart [1] + (visiblePage ? pageWidth : 0));  // 0 to 1023 -> 0 to 80 on line 2
 }
 
-void writeString (const char *words)
+void displayFrequency ()            // Writes the frequency view into the hidden page of the LCD
 {
-    while (*words)          // While the *words pointer is not pointing to the NULL char do what is inside the brackets
+    if (freqHertz == 0.0)
     {
-        lcdData = *words;   // Load what the *words pointer is pointing to into the variable lcdData
-        lcdOut ();          // Call the subroutine to pass the data to the LCD
-        *words ++;          // Increment the contents of the pointer so that it is pointing to the next char in the array
+        pageWriteLine (hiddenPage, 0, "No signal on RC2");
+        pageWriteLine (hiddenPage, 1, "");
+        return;
     }
+    if (freqHertz < 1000.0) sprintf(str, "%.3f Hz", freqHertz);
+    else sprintf(str, "%.3f kHz", freqHertz / 1000.0);
+    pageWriteLine (hiddenPage, 0, str);
+    if (freqDutyPercent == freqNoDuty) sprintf(str, "%.2f us", freqPeriodUs);
+    else sprintf(str, "Duty %u%%", freqDutyPercent);
+    pageWriteLine (hiddenPage, 1, str);
 }
 
-void systemVoltage ()           // Starts a conversion and stores the result into a variable called sysVoltage. 
-                                // Note: systemVoltage must be of type float as it will be a decimal number
+void __interrupt() isr (void)
 {
-    ADCON0bits.GODONE = 1;                                      // Starts the ADC conversion by setting bit 1 of ADCON0
-    while (ADCON0bits.GODONE);                                  // Waits for bit 1 of the ADCON0 register to go to logic '0'. 
-                                                                // This happens automatically when the conversion ends
-    sysVoltage = (ADRESH*0.01953 + (ADRESL >> 6) * 0.0049);     // Converts the binary value from the ADC to the actual voltage
+    freqInterrupt ();               // Edge times from CCP1, first so it sees Timer 1 overflows before they are cleared
+    logInterrupt ();                // Next byte of the EEPROM log
+#ifdef PROFILE
+    profileInterrupt ();            // Timer 1 overflows for the profiler
+#endif
+#ifdef TRACE
+    traceInterrupt ();              // and for the trace time stamps
+#endif
 }
 
-void displayVoltage (float dp)      // Creates a subroutine to display the voltage on the LCD
+#ifdef PROFILE
+
+void displayProfile ()              // Shows each line of the profile table for 2 seconds
 {
-    sprintf(str, "%.2f", dp);       // This use of the function sprintf to display the floating point value using 2 decimal points
-    writeString (str);              // Calls the writeStringsubroutine to send the value to the LCD
-    writeString (" Volts");         // Calls the writeString subroutine to send the word Volts to the LCD
+    unsigned char id;
+    char line2[22];
+    id = 0;
+    while (id < profileProbes)
+    {
+        profileText (id, str, line2);
+        pageWriteLine (hiddenPage, 0, str);
+        pageWriteLine (hiddenPage, 1, line2);
+        pageShow (hiddenPage);
+        __delay_ms(2000);
+        id ++;
+    }
+    profileClear ();
 }
 
+#endif
+
 // Main Program
 
 void main ()
 {
     initializeThePic ();
-    setUpTheLCD ();
+#ifdef adcCalibrateOnce
+    adcSettingSetUp ();             // Before logSetUp, which turns on the EEPROM interrupt
+#endif
+#ifdef PROFILE
+    profileSetUp ();
+#endif
+#ifdef TRACE
+    traceSetUp ();
+    traceFreezeOn (traceButton, 32);    // Keep what happened around the first button change
+#endif
+    logSetUp ();                    // Finds the newest record, about 12ms, while the LCD is still powering up
+    freqSetUp ();
+    systemVoltage ();               // The first reading is taken while the LCD is still powering up
+    minVoltage = sysVoltage;
+    maxVoltage = sysVoltage;
+    while (timeSinceReset () < lcdPowerOnTicks);  // Only wait for what is left of the 32ms
+    setUpTheLCDQuick ();            // It finishes with returnHome so page 0 is showing, no need for pagesSetUp
+    displayVoltage (sysVoltage);
+    pageShow (hiddenPage);
+    bootTicks = timeSinceReset ();  // 10,626 ticks (42.5ms) with adcSetting given or kept in the EEPROM, 25,602 (102.4ms) when adcCalibrate runs
+                                    // and its setting is written, 22,449 (89.8ms) with the old blind 32ms wait and setUpTheLCD. From the PC
+                                    // build with PIC_AN0="const:2.5", which counts the delays and register accesses but not the C in between,
+                                    // so the PIC takes a little longer (sprintf most of it)
+#ifdef PIN_HOST_BACKEND
+    printf ("bootTicks=%u\n", bootTicks);  // The PC build (host/xc.h) prints it as it cannot be watched
+#endif
     while (1)
     {
-        writeString ("The Voltage is");
-        line2 ();                       // Call the subroutine line2 to move the cursor to the beginning of line two on the LCD
         systemVoltage ();               // Calls the subroutine systemVoltage to go and measure the voltage
-        displayVoltage (sysVoltage);    // Calls the subroutine displayVoltage to display the voltage on the LCD
-        gohome ();                      // Calls the subroutine gohome to send the cursor on the LCD back to the home position
+        if (sysVoltage < minVoltage) minVoltage = sysVoltage;
+        if (sysVoltage > maxVoltage) maxVoltage = sysVoltage;
+        logAdd (adcReading);
+#ifdef PIN_HOST_BACKEND
+        if (freqUpdate ()) printf ("freqHertz=%.3f freqPeriodUs=%.4f freqDutyPercent=%u\n", freqHertz, freqPeriodUs, freqDutyPercent);
+#else
+        freqUpdate ();
+#endif
+        if (pinRead (viewButton) != lastButton) traceEvent (traceButton, pinRead (viewButton));
+        if (pinRead (viewButton) && !lastButton)                // Next view each time the button is pressed
+        {
+            view = view == freqView ? voltageView : view + 1;
+            if (view == barView)
+            {
+                barSetUp ();
+                barReadings = 0;
+            }
+        }
+        lastButton = pinRead (viewButton);
+        if (view == barView) displayBar ();
+        else
+        {
+            if (view == voltageView) displayVoltage (sysVoltage);   // The next screen goes into the page that cannot be seen
+            else if (view == statsView) displayStats ();
+            else if (view == historyView) displayHistory ();
+            else displayFrequency ();
+            pageShow (hiddenPage);      // and then it is shown all at once
+        }
+#ifdef PROFILE
+        if (pinRead (dumpButton)) displayProfile ();
+#endif
+#ifdef TRACE
+        if (pinRead (dumpButton)) traceDump ();
+#endif
     }
 }
@@ -0,0 +1,149 @@
+/*
+ * File:   adcTiming_HHWardBook1.h
+ * Name: Finding the fastest ADC timing that still gives good readings
+ *
+ * ADCON2 sets two times. The conversion clock (ADCS, bits 2:0) gives TAD, the time for
+ * one bit of the conversion, which must be at least 0.7us on the PIC18F4525. A conversion
+ * takes 11 TAD. The acquisition time (ACQT, bits 5:3) is 2 to 20 TAD of waiting while the
+ * hold capacitor charges to the input before the conversion starts. How long that has to
+ * be depends on the resistance of whatever drives the pin.
+ *
+ *      ADCS    TAD             valid at 8MHz       ACQT    acquisition
+ *      000     2 / FOSC        no (0.25us)         001     2 TAD
+ *      100     4 / FOSC        no (0.5us)          010     4 TAD
+ *      001     8 / FOSC        yes (1us)           011     6 TAD
+ *      101     16 / FOSC       yes (2us)           100     8 TAD
+ *      010     32 / FOSC       yes (4us)           101     12 TAD
+ *      110     64 / FOSC       yes (8us)           110     16 TAD
+ *      011     RC, 1.2 to 2.5us, not tried         111     20 TAD
+ *
+ * adcCalibrate (channel) tries every ACQT with every ADCS divide of FOSC that is valid for
+ * _XTAL_FREQ, so 2 / FOSC and 4 / FOSC are tried when the oscillator is slow enough. The
+ * RC clock is left out: the data sheet only recommends it above 1MHz for conversions done
+ * in Sleep, which these are not, and its TAD changes with the part and the temperature.
+ * For each it takes adcTrials readings of the channel, each straight after a reading of
+ * adcDisturbChannel so the hold capacitor starts from somewhere else, as it does when a
+ * program reads more than one channel. It records the time in instruction cycles (Timer 1),
+ * the spread of the readings (variance) and how far their mean is from the slowest setting.
+ * The fastest setting within both budgets is put into ADCON2 and returned, or the slowest
+ * if none is.
+ *
+ * At 8MHz there are 28 settings and it takes about 80ms. The results stay in the adcTiming
+ * arrays so they can be looked at in the simulator or sent to a PC. The reference, the
+ * slowest setting, is the first of them with an error of 0.
+ *
+ * _XTAL_FREQ must be defined before including this file.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef ADCTIMING_HHWARDBOOK1_H
+#define ADCTIMING_HHWARDBOOK1_H
+
+#ifndef adcDisturbChannel
+#define adcDisturbChannel   1       // Read before each trial reading, set it to the channel itself to leave it out
+#endif
+#ifndef adcNoiseBudget
+#define adcNoiseBudget      16      // Largest variance allowed, in 1/16 counts squared, 16 = 1 count squared
+#endif
+#ifndef adcErrorBudget
+#define adcErrorBudget      16      // Largest mean difference from the slowest setting, in 1/16 counts
+#endif
+#define adcTrials           16      // Readings for each setting
+#define adcClocks           6       // Conversion clocks that can be tried
+#define adcSettings         43      // Most settings that can be tried, the reference then 6 clocks x 7 acquisition times
+#define adcSlowest          0b111110    // 20 TAD acquisition with FOSC/64
+
+const unsigned char adcClockBits [adcClocks] = {0b000, 0b100, 0b001, 0b101, 0b010, 0b110};   // FOSC/2, /4, /8, /16, /32 and /64
+const unsigned char adcClockDivide [adcClocks] = {2, 4, 8, 16, 32, 64};
+
+// Some variables
+unsigned char adcTimingCount;                       // Settings tried
+unsigned char adcTimingSetting [adcSettings];       // ADCON2 bits 5:0 of each
+unsigned int adcTimingCycles [adcSettings];         // Instruction cycles for one reading
+unsigned int adcTimingVariance [adcSettings];       // In 1/16 counts squared
+unsigned int adcTimingError [adcSettings];          // Mean difference from the slowest setting in 1/16 counts
+unsigned char adcTimingBest;                        // Which one was chosen
+
+// The subroutines
+
+unsigned int adcRead (unsigned char channel)    // One 10-bit reading with the timing in ADCON2 at the moment
+{
+    ADCON0 = (channel << 2) | 0x01;             // Select the channel, ADC on
+    ADCON0bits.GODONE = 1;
+    while (ADCON0bits.GODONE);
+    if (ADCON2bits.ADFM) return ((unsigned int) ADRESH << 8) | ADRESL;
+    return ((unsigned int) ADRESH << 2) | (ADRESL >> 6);
+}
+
+unsigned int adcTimer ()            // Timer 1 in instruction cycles
+{
+    unsigned char low;
+    low = TMR1L;                    // Reading TMR1L copies the high byte into TMR1H (RD16)
+    return ((unsigned int) TMR1H << 8) | low;
+}
+
+void adcTry (unsigned char setting, unsigned char channel, unsigned long *mean16)
+{                                   // Measures one setting, mean16 gives back the mean in 1/16 counts
+    unsigned char n;
+    unsigned int reading, start, cycles;
+    unsigned long sum, squares, variance;
+    ADCON2 = (ADCON2 & 0b11000000) | setting;
+    sum = 0;
+    squares = 0;
+    cycles = 0;
+    n = 0;
+    while (n < adcTrials)
+    {
+        adcRead (adcDisturbChannel);
+        start = adcTimer ();
+        reading = adcRead (channel);
+        cycles += adcTimer () - start;
+        sum += reading;
+        squares += (unsigned long) reading * reading;
+        n ++;
+    }
+    adcTimingSetting [adcTimingCount] = setting;
+    adcTimingCycles [adcTimingCount] = cycles / adcTrials;
+    variance = (adcTrials * squares - sum * sum) * 16 / (adcTrials * adcTrials);
+    adcTimingVariance [adcTimingCount] = variance > 0xFFFF ? 0xFFFF : variance;
+    *mean16 = sum * 16 / adcTrials;
+}
+
+unsigned char adcCalibrate (unsigned char channel)  // Tries every valid setting, puts the best in ADCON2 and returns it
+{
+    unsigned char clock, acquisition, best;
+    unsigned long mean16, reference;
+    if (!T1CONbits.TMR1ON) T1CON = 0b10000001;      // Timer 1 at 1:1 unless something else is already running it
+    adcTimingCount = 0;
+    adcTry (adcSlowest, channel, &reference);       // The slowest setting is the reference, kept as the first
+    adcTimingError [0] = 0;
+    adcTimingCount = 1;
+    best = 0xFF;
+    clock = 0;
+    while (clock < adcClocks)
+    {
+        if ((unsigned long) adcClockDivide [clock] * 10000000UL >= 7UL * _XTAL_FREQ)
+        {                           // TAD = divide / FOSC must be at least 0.7us
+            acquisition = 1;
+            while (acquisition < 8)
+            {
+                adcTry (acquisition << 3 | adcClockBits [clock], channel, &mean16);
+                adcTimingError [adcTimingCount] = mean16 > reference ? mean16 - reference : reference - mean16;
+                if (adcTimingVariance [adcTimingCount] <= adcNoiseBudget && adcTimingError [adcTimingCount] <= adcErrorBudget
+                    && (best == 0xFF || adcTimingCycles [adcTimingCount] < adcTimingCycles [best]))
+                    best = adcTimingCount;
+                adcTimingCount ++;
+                acquisition ++;
+            }
+        }
+        clock ++;
+    }
+    if (best == 0xFF) best = 0;     // Nothing was good enough, use the reference
+    adcTimingBest = best;
+    ADCON2 = (ADCON2 & 0b11000000) | adcTimingSetting [best];
+    ADCON0 = (channel << 2) | 0x01; // Leave the channel selected as it was asked for
+    return ADCON2;
+}
+
+#endif
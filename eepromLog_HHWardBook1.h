@@ -0,0 +1,246 @@
+/*
+ * File:   eepromLog_HHWardBook1.h
+ * Name: Keeping a history of readings in the data EEPROM
+ *
+ * logAdd (reading) collects the lowest, highest and mean of logPeriod 10-bit readings in
+ * RAM. When the period is over they are put into an 8 byte record:
+ *
+ *      0 to 2      sequence number, low byte first, goes up by one every record
+ *      3, 4, 5     top 8 bits of min, max and mean
+ *      6           bottom 2 bits of min (bits 7:6), max (5:4) and mean (3:2)
+ *      7           checksum, 0xFF minus the sum of bytes 0 to 6
+ *
+ * The 1024 bytes of EEPROM hold 128 records and they are written one after the other all
+ * the way round, so every byte is written the same number of times. A program that needs
+ * some of the EEPROM for itself defines logRecords as fewer before including this file and
+ * has the bytes after them, e.g. 127 leaves the last 8 from address 1016. The newest record is
+ * the valid one with the highest sequence number. A record being written when the power
+ * went off has the wrong checksum and is ignored, as is an erased one (all 0xFF).
+ *
+ * Each byte takes about 4ms to write. The records wait in a RAM queue and the EEPROM
+ * interrupt (EEIF) starts the next byte when the last one is done, so the program never
+ * waits for the EEPROM. If the queue is full when a record is finished it is lost and
+ * logLost goes up.
+ *
+ * Time taken from the program (Tcy = 0.5us at 8MHz):
+ *
+ *      logAdd                                      about 40 Tcy      20us
+ *      logAdd when a record is finished            about 250 Tcy    125us
+ *      EEIF interrupt, one byte started            about 60 Tcy      30us
+ *      logSetUp, all 128 records checked           about 25000 Tcy  12.5ms, once at switch on
+ *
+ * so the longest the main loop is held up is about 155us, when a record is finished and
+ * an interrupt comes at the same time.
+ *
+ * Lifetime: each byte is written once every 128 records. The data EEPROM is good for at
+ * least 100,000 writes (1,000,000 typical). VoltMeter_main.c takes about 100 readings a
+ * second, so with logPeriod = 6000 there is a record a minute and each byte is written
+ * every 128 minutes: at least 100,000 x 128 minutes = 24 years (243 years typical).
+ *
+ * The program must call logSetUp () once and logInterrupt () from its interrupt routine.
+ * logWriteByte waits for its byte to be written, so it is only for before logSetUp.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef EEPROMLOG_HHWARDBOOK1_H
+#define EEPROMLOG_HHWARDBOOK1_H
+
+#ifndef logPeriod
+#define logPeriod       6000        // Readings in each record
+#endif
+#define logRecordSize   8
+#ifndef logRecords
+#define logRecords      128         // 1024 bytes of EEPROM / 8
+#endif
+#define logQueueSize    32          // Bytes of records waiting to be written, 4 records, must be a power of 2
+
+// Some variables
+unsigned int logMin, logMax, logCount;      // The record being collected
+unsigned long logSum;
+unsigned long logSequence;                  // Sequence number of the next record, 24 bits used
+unsigned int logAddress;                    // EEPROM address the next byte goes to
+unsigned char logQueue [logQueueSize];
+volatile unsigned char logHead, logTail;    // Where the next byte goes in and where the interrupt takes it out
+volatile unsigned char logWriting;          // 1 while the EEPROM is busy with a byte from the queue
+unsigned int logLost;                       // Records that did not fit in the queue
+unsigned char logValid;                     // 1 once there is at least one record
+unsigned int logLastMin, logLastMax, logLastMean;   // The newest record, from the EEPROM at switch on and then from logAdd
+
+// The subroutines
+
+unsigned char logRead (unsigned int address)    // Reads one byte of the data EEPROM
+{
+    EEADRH = address >> 8;          // Only used before the interrupt starts writing, they share EEADR
+    EEADR = address & 0xFF;
+    EECON1bits.EEPGD = 0;           // Data EEPROM, not program memory
+    EECON1bits.CFGS = 0;
+    EECON1bits.RD = 1;              // The byte is in EEDATA on the next instruction
+    return EEDATA;
+}
+
+void logWriteByte (unsigned int address, unsigned char info)   // Writes one byte and waits about 4ms for it, before logSetUp only
+{
+    EEADRH = address >> 8;
+    EEADR = address & 0xFF;
+    EEDATA = info;
+    EECON1bits.EEPGD = 0;
+    EECON1bits.CFGS = 0;
+    EECON1bits.WREN = 1;
+    EECON2 = 0x55;                  // The unlock sequence, the interrupts are still off
+    EECON2 = 0xAA;
+    EECON1bits.WR = 1;
+    while (EECON1bits.WR);          // Cleared when the byte is written
+    EECON1bits.WREN = 0;
+    PIR2bits.EEIF = 0;
+}
+
+void logStartByte ()                // Starts writing the next byte in the queue, the interrupts must be off
+{
+    EEADRH = logAddress >> 8;
+    EEADR = logAddress & 0xFF;
+    EEDATA = logQueue [logTail];
+    logTail = (logTail + 1) & (logQueueSize - 1);
+    logAddress ++;
+    if (logAddress == logRecords * logRecordSize) logAddress = 0;
+    EECON1bits.EEPGD = 0;
+    EECON1bits.CFGS = 0;
+    EECON1bits.WREN = 1;
+    EECON2 = 0x55;                  // The unlock sequence, it must be these three instructions one after the other
+    EECON2 = 0xAA;
+    EECON1bits.WR = 1;
+    logWriting = 1;
+}
+
+void logInterrupt ()                // Call this from the interrupt routine
+{
+    if (PIE2bits.EEIE && PIR2bits.EEIF)     // The last byte has been written
+    {
+        PIR2bits.EEIF = 0;
+        if (logTail != logHead) logStartByte ();
+        else
+        {
+            EECON1bits.WREN = 0;    // Nothing left, stop any write by accident
+            logWriting = 0;
+        }
+    }
+}
+
+unsigned char logRecordGood (unsigned char record, unsigned long *sequence)   // Checks a record and gives its sequence number
+{
+    unsigned char n, info, sum;
+    unsigned int address;
+    address = (unsigned int) record * logRecordSize;
+    sum = 0;
+    *sequence = 0;
+    n = 0;
+    while (n < logRecordSize - 1)
+    {
+        info = logRead (address + n);
+        sum += info;
+        if (n < 3) *sequence |= (unsigned long) info << (8 * n);
+        n ++;
+    }
+    return logRead (address + logRecordSize - 1) == (unsigned char) (0xFF - sum);
+}
+
+void logRecordRead (unsigned char record, unsigned int *min, unsigned int *max, unsigned int *mean)
+{                                   // Reads min, max and mean back out of a record
+    unsigned int address;
+    unsigned char low;
+    address = (unsigned int) record * logRecordSize;
+    low = logRead (address + 6);
+    *min = ((unsigned int) logRead (address + 3) << 2) | (low >> 6);
+    *max = ((unsigned int) logRead (address + 4) << 2) | ((low >> 4) & 0x03);
+    *mean = ((unsigned int) logRead (address + 5) << 2) | ((low >> 2) & 0x03);
+}
+
+void logSetUp ()                    // Finds the newest record so the log carries on after it
+{
+    unsigned char record, newest;
+    unsigned long sequence;
+    logValid = 0;
+    newest = 0;
+    record = 0;
+    while (record < logRecords)
+    {
+        if (logRecordGood (record, &sequence)
+            && (!logValid || ((sequence - logSequence) & 0x800000) == 0))   // Newer, allowing for the 24 bits going round
+        {
+            logSequence = sequence;
+            newest = record;
+            logValid = 1;
+        }
+        record ++;
+    }
+    if (logValid)
+    {
+        logRecordRead (newest, &logLastMin, &logLastMax, &logLastMean);
+        logAddress = newest + 1 == logRecords ? 0 : (newest + 1) * logRecordSize;
+        logSequence = (logSequence + 1) & 0xFFFFFF;
+    }
+    else
+    {
+        logAddress = 0;
+        logSequence = 0;
+    }
+    logCount = 0;
+    logHead = 0;
+    logTail = 0;
+    logWriting = 0;
+    PIR2bits.EEIF = 0;
+    PIE2bits.EEIE = 1;
+    INTCONbits.PEIE = 1;
+    INTCONbits.GIE = 1;
+}
+
+void logQueueAdd (unsigned char info, unsigned char *sum)
+{
+    logQueue [logHead] = info;
+    logHead = (logHead + 1) & (logQueueSize - 1);
+    *sum += info;
+}
+
+void logFinish ()                   // Puts the finished record in the queue and starts the writing if it is not going
+{
+    unsigned int mean;
+    unsigned char sum, gie;
+    mean = logSum / logCount;
+    logLastMin = logMin;            // Kept in RAM as well, the EEPROM copy takes 32ms to write
+    logLastMax = logMax;
+    logLastMean = mean;
+    logValid = 1;
+    if (((logTail - logHead - 1) & (logQueueSize - 1)) < logRecordSize)
+    {
+        logLost ++;
+        return;
+    }
+    sum = 0;
+    logQueueAdd (logSequence & 0xFF, &sum);
+    logQueueAdd ((logSequence >> 8) & 0xFF, &sum);
+    logQueueAdd ((logSequence >> 16) & 0xFF, &sum);
+    logQueueAdd (logMin >> 2, &sum);
+    logQueueAdd (logMax >> 2, &sum);
+    logQueueAdd (mean >> 2, &sum);
+    logQueueAdd ((logMin & 0x03) << 6 | (logMax & 0x03) << 4 | (mean & 0x03) << 2, &sum);
+    logQueueAdd (0xFF - sum, &sum);
+    logSequence = (logSequence + 1) & 0xFFFFFF;
+    gie = INTCONbits.GIE;
+    INTCONbits.GIE = 0;             // The unlock sequence must not be interrupted
+    if (!logWriting) logStartByte ();
+    INTCONbits.GIE = gie;
+}
+
+void logAdd (unsigned int reading)  // Adds one 10-bit reading to the record being collected
+{
+    if (!logCount || reading < logMin) logMin = reading;
+    if (!logCount || reading > logMax) logMax = reading;
+    if (!logCount) logSum = 0;
+    logSum += reading;
+    logCount ++;
+    if (logCount < logPeriod) return;
+    logFinish ();
+    logCount = 0;
+}
+
+#endif
@@ -0,0 +1,115 @@
+/*
+ * File:   fixedMath_HHWardBook1.h
+ * Name: Whole number and fixed point arithmetic built on the 8 x 8 hardware multiplier
+ *
+ * The PIC18 multiplies two 8-bit numbers in one instruction (MULWF, the answer goes into
+ * PRODH:PRODL). XC8 uses it for unsigned char x unsigned char, but a multiply of two ints
+ * or longs calls a general library subroutine that works through the bits. These build
+ * the bigger multiplies out of 8 x 8 ones instead:
+ *
+ *      mul8 (a, b)             8 x 8 -> 16, one MULWF
+ *      mul16x8 (a, b)          16 x 8 -> 24, two MULWFs
+ *      mul16 (a, b)            16 x 16 -> 32, four MULWFs
+ *      mulHigh16 (a, b)        the top 16 bits of 16 x 16, e.g. a x b / 65536
+ *      mulQ8 (a, b)            signed Q8.8 (8 bits whole number, 8 bits fraction)
+ *      mulQ15 (a, b)           signed Q1.15 (a fraction from -1 to just under 1)
+ *      divideBy (x, d, r)      x / d with r = fixedReciprocal (d), one mulHigh16 and a check
+ *      addSaturate (a, b)      signed 16-bit add that stops at 32767 and -32768
+ *      addSaturateU (a, b)     unsigned 16-bit add that stops at 65535
+ *
+ * The signed multiplies work on the size of the numbers and put the sign back at the end,
+ * so they round towards 0, and an answer too big for 16 bits is held at 32767 or -32768.
+ * All of them give the same answers as the long arithmetic. host/fixedMathTest.c checks
+ * this on a PC for every pair of 16-bit inputs, and in divideBy for every x with every d
+ * from 2 to 65535.
+ * Kernels 14 to 17 of MicroBench_main.c measure them against XC8's own subroutines.
+ *
+ * Example, ADC reading (0 to 1023) to millivolts with a 5V reference, no float:
+ *      millivolts = mulHigh16 (reading << 6, 5000);    // reading x 5000 / 1024
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef FIXEDMATH_HHWARDBOOK1_H
+#define FIXEDMATH_HHWARDBOOK1_H
+
+#define mul8(a, b)          ((unsigned int) (unsigned char) (a) * (unsigned char) (b))     // MULWF
+#define fixedReciprocal(d)  ((unsigned int) (65536UL / (d)))   // Work it out at compile time for a constant d
+#define toQ8(x)             ((int) ((x) * 256))                 // e.g. toQ8 (1.5) = 384, for constants
+#define toQ15(x)            ((int) ((x) * 32768))               // e.g. toQ15 (0.5) = 16384
+
+// The subroutines
+
+__uint24 mul16x8 (unsigned int a, unsigned char b)     // 16 x 8 -> 24 bits
+{
+    return ((__uint24) mul8 (a >> 8, b) << 8) + mul8 (a & 0xFF, b);
+}
+
+unsigned long mul16 (unsigned int a, unsigned int b)    // 16 x 16 -> 32 bits
+{
+    unsigned long result;
+    unsigned int middle;
+    unsigned char carry;
+    result = ((unsigned long) mul8 (a >> 8, b >> 8) << 16) | mul8 (a & 0xFF, b & 0xFF);
+    middle = mul8 (a >> 8, b & 0xFF);
+    carry = 0;
+    middle += mul8 (a & 0xFF, b >> 8);
+    if (middle < mul8 (a & 0xFF, b >> 8)) carry = 1;   // The two middle products went past 16 bits
+    result += (unsigned long) middle << 8;
+    if (carry) result += 0x1000000;
+    return result;
+}
+
+unsigned int mulHigh16 (unsigned int a, unsigned int b) // (a x b) >> 16
+{
+    return mul16 (a, b) >> 16;
+}
+
+int fixedSigned (unsigned long size, unsigned char negative)   // Puts the sign back and holds the answer inside 16 bits
+{
+    if (negative) return size >= 32768 ? -32768 : -(int) size;
+    return size > 32767 ? 32767 : (int) size;
+}
+
+int mulQ8 (int a, int b)            // Q8.8 x Q8.8 -> Q8.8
+{
+    unsigned int sizeA, sizeB;
+    sizeA = a < 0 ? -(unsigned int) a : (unsigned int) a;
+    sizeB = b < 0 ? -(unsigned int) b : (unsigned int) b;
+    return fixedSigned (mul16 (sizeA, sizeB) >> 8, (a < 0) != (b < 0));
+}
+
+int mulQ15 (int a, int b)           // Q1.15 x Q1.15 -> Q1.15
+{
+    unsigned int sizeA, sizeB;
+    sizeA = a < 0 ? -(unsigned int) a : (unsigned int) a;
+    sizeB = b < 0 ? -(unsigned int) b : (unsigned int) b;
+    return fixedSigned (mul16 (sizeA, sizeB) >> 15, (a < 0) != (b < 0));
+}
+
+unsigned int divideBy (unsigned int x, unsigned int d, unsigned int reciprocal)
+{                                   // x / d, reciprocal must be fixedReciprocal (d), d more than 1
+    unsigned int answer, left;
+    answer = mulHigh16 (x, reciprocal);     // This is never too big and at most 1 too small
+    left = x - (unsigned int) mul16 (answer, d);
+    if (left >= d) answer ++;
+    return answer;
+}
+
+int addSaturate (int a, int b)
+{
+    int sum;
+    sum = (int) ((unsigned int) a + (unsigned int) b);
+    if (a >= 0 && b >= 0 && sum < 0) return 32767;      // Two positives cannot make a negative
+    if (a < 0 && b < 0 && sum >= 0) return -32768;
+    return sum;
+}
+
+unsigned int addSaturateU (unsigned int a, unsigned int b)
+{
+    unsigned int sum;
+    sum = a + b;
+    return sum < a ? 0xFFFF : sum;
+}
+
+#endif
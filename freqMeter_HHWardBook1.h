@@ -0,0 +1,215 @@
+/*
+ * File:   freqMeter_HHWardBook1.h
+ * Name: Measuring frequency, period and duty cycle with CCP1 capture
+ *
+ * The signal goes into RC2/CCP1. In capture mode CCP1 copies Timer 1 into CCPR1 the
+ * instant an edge arrives, so the time of each edge is exact to one instruction cycle
+ * however long the interrupt takes to get to it. The interrupt adds the Timer 1 overflow
+ * count on top to make a 32-bit time, which goes round every 35 minutes.
+ *
+ * Reciprocal counting: rather than counting edges for a fixed time (1Hz resolution in a
+ * 1 second gate) it counts whole periods and measures the time they took. A result is
+ * made at the first edge after freqGate cycles, so
+ *
+ *      frequency = periods x FOSC/4 / cycles
+ *
+ * is good to 1 cycle in at least 200,000 (5ppm with the 100ms gate) at any frequency.
+ * A slow signal just makes the gate longer, up to one whole period. With no edge for
+ * freqTimeout Timer 1 overflows (about 2 seconds) the frequency is 0.
+ *
+ * Two ranges, picked by freqUpdate as the frequency changes:
+ *
+ *      freqDuty        every edge, rising and falling, gives duty as well. Used up to 2kHz
+ *      freqEvery16     every 16th rising edge (the CCP prescaler), frequency only
+ *
+ * Interrupt load, at 8MHz (Tcy = 0.5us), measured with the PC build of VoltMeter_main.c
+ * (host/xc.h) with PIC_CCP1 giving the signal and PIC_STATS=1, the difference between a
+ * 3 and a 6 second run so the start in freqDuty is left out:
+ *
+ *      one capture interrupt including saving registers    40 Tcy          20us
+ *      freqDuty at 2kHz, 4030 interrupts a second          8.3% of the time
+ *      freqEvery16 at 100kHz, 6280 interrupts a second     12.2%
+ *      freqEvery16 at 350kHz                               42.7%
+ *      freqEvery16 at 797kHz                               97%, the most it reads to 0.1%
+ *
+ * The PC build counts 30 Tcy to go in and out of the interrupt (PIC_ISR_TCY) and one for
+ * each register access, but nothing for the C in between, so the PIC takes longer than
+ * this. With PIC_ISR_TCY=90, 100 Tcy an interrupt, it is 20% at 2kHz, 31% at 100kHz and
+ * the most it reads is 319kHz. Time freqInterrupt with the simulator's stopwatch to know
+ * which is nearer.
+ *
+ * In freqDuty the high and the low part of the signal must each be longer than one
+ * interrupt, 20us or more, or an edge is missed.
+ *
+ * Timer 1 is shared with profile_HHWardBook1.h and trace_HHWardBook1.h, all at 1:1. When
+ * either is compiled in its overflow count is used, otherwise freqInterrupt counts them.
+ * All three counts are 16 bits so the time only wraps after 35 minutes.
+ * freqInterrupt must be called before profileInterrupt and traceInterrupt so it sees
+ * TMR1IF before they clear it. freqSetUp sets T3CCP2 = 0 so CCP1 uses Timer 1, which
+ * leaves scopeCapture_HHWardBook1.h's Timer 3 for CCP2 alone.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef FREQMETER_HHWARDBOOK1_H
+#define FREQMETER_HHWARDBOOK1_H
+
+#ifndef freqGate
+#define freqGate        200000UL    // Shortest measurement in Tcy, 100ms at 8MHz
+#endif
+#define freqTimeout     61          // Timer 1 overflows (32.8ms each) with no edge before the frequency is 0
+#define freqDuty        0           // Values of freqRange
+#define freqEvery16     1
+#define freqRising      0b00000101  // CCP1CON capture on every rising edge
+#define freqFalling     0b00000100  // every falling edge
+#define freqRising16    0b00000111  // every 16th rising edge
+#define freqUpHertz     2000.0      // Above this freqEvery16 is used
+#define freqDownHertz   1000.0      // and below this freqDuty is used again
+#define freqNoDuty      0xFF        // freqDutyPercent when the duty is not known
+
+#ifdef TRACE
+#include "trace_HHWardBook1.h"
+#define freqOverflows traceOverflows        // The same count as the trace, and the profiler if that is in too
+#elif defined PROFILE
+#include "profile_HHWardBook1.h"
+#define freqOverflows profileOverflows
+#else
+volatile unsigned int freqOverflows;        // Timer 1 overflows, the top 16 bits of the time
+#endif
+
+// Some variables
+volatile unsigned char freqRange;           // freqDuty or freqEvery16
+volatile unsigned char freqEdge;            // In freqDuty, 1 when waiting for a falling edge
+volatile unsigned char freqStarted;         // 1 once the first rising edge of a measurement is in
+unsigned long freqFirst, freqLastRise;      // Times of the first and latest rising edges
+unsigned int freqPeriods;                   // Captures since freqFirst
+unsigned long freqHighSum;                  // Cycles the signal was high since freqFirst
+volatile unsigned int freqLastEdge;         // freqOverflows at the latest edge, for the timeout
+volatile unsigned char freqReady;           // 1 when the interrupt has a new result
+unsigned long freqResultCycles, freqResultHigh; // The result
+unsigned int freqResultPeriods;
+unsigned char freqResultRange;
+float freqHertz;                            // What freqUpdate worked out
+float freqPeriodUs;
+unsigned char freqDutyPercent = freqNoDuty;
+
+// The subroutines
+
+void freqStart (unsigned char range)        // Starts a new measurement in one range
+{
+    PIE1bits.CCP1IE = 0;
+    CCP1CON = 0x00;                         // Off first, changing the mode can make a false capture
+    freqRange = range;
+    freqEdge = 0;
+    freqStarted = 0;
+    CCP1CON = range == freqDuty ? freqRising : freqRising16;
+    PIR1bits.CCP1IF = 0;
+    PIE1bits.CCP1IE = 1;
+}
+
+void freqSetUp ()
+{
+    TRISCbits.TRISC2 = 1;                   // CCP1 is an input
+    T3CONbits.T3CCP2 = 0;                   // CCP1 is on Timer 1 with T3CCP1 either way
+    if (!T1CONbits.TMR1ON) T1CON = 0b10000001;  // RD16, 1:1, unless the profiler or trace has it going already
+    freqLastEdge = freqOverflows;
+    PIR1bits.TMR1IF = 0;
+    PIE1bits.TMR1IE = 1;
+    freqStart (freqDuty);
+    INTCONbits.PEIE = 1;
+    INTCONbits.GIE = 1;
+}
+
+void freqInterrupt ()                       // Call this from the interrupt routine, before profileInterrupt and traceInterrupt
+{
+    unsigned int captured, high;
+    unsigned long now;
+    if (PIE1bits.CCP1IE && PIR1bits.CCP1IF)
+    {
+        captured = CCPR1;
+        high = freqOverflows;
+        if (PIR1bits.TMR1IF && captured < 0x8000) high ++;  // Timer 1 went round before the edge but it is not counted yet
+        now = (unsigned long) high << 16 | captured;
+        freqLastEdge = high;
+        if (freqRange == freqDuty)
+        {
+            CCP1CON = 0x00;                 // Look for the other edge next
+            CCP1CON = freqEdge ? freqRising : freqFalling;
+        }
+        PIR1bits.CCP1IF = 0;
+        if (freqEdge)                       // A falling edge, the end of the high part
+        {
+            freqEdge = 0;
+            if (freqStarted) freqHighSum += now - freqLastRise;
+        }
+        else
+        {
+            freqEdge = freqRange == freqDuty;
+            if (!freqStarted)
+            {
+                freqFirst = now;
+                freqPeriods = 0;
+                freqHighSum = 0;
+                freqStarted = 1;
+            }
+            else
+            {
+                freqPeriods ++;
+                if (now - freqFirst >= freqGate)    // Long enough, this edge ends one measurement and starts the next
+                {
+                    freqResultCycles = now - freqFirst;
+                    freqResultPeriods = freqPeriods;
+                    freqResultHigh = freqHighSum;
+                    freqResultRange = freqRange;
+                    freqReady = 1;
+                    freqFirst = now;
+                    freqPeriods = 0;
+                    freqHighSum = 0;
+                }
+            }
+            freqLastRise = now;
+        }
+    }
+#if !defined PROFILE && !defined TRACE
+    if (PIE1bits.TMR1IE && PIR1bits.TMR1IF)
+    {
+        PIR1bits.TMR1IF = 0;
+        freqOverflows ++;
+    }
+#endif
+}
+
+unsigned char freqUpdate ()                 // Call this often, it gives 1 when freqHertz, freqPeriodUs and freqDutyPercent are new
+{
+    unsigned long cycles, highCycles;
+    unsigned int periods, quiet;
+    unsigned char range, gie;
+    gie = INTCONbits.GIE;
+    INTCONbits.GIE = 0;                     // Copy the result in one piece
+    quiet = freqOverflows - freqLastEdge;
+    if (!freqReady)
+    {
+        INTCONbits.GIE = gie;
+        if (quiet < freqTimeout || freqHertz == 0.0) return 0;
+        freqHertz = 0.0;                    // No edges for 2 seconds
+        freqPeriodUs = 0.0;
+        freqDutyPercent = freqNoDuty;
+        freqStart (freqDuty);               // So the gap is not taken as one long period
+        return 1;
+    }
+    cycles = freqResultCycles;
+    periods = freqResultPeriods;
+    highCycles = freqResultHigh;
+    range = freqResultRange;
+    freqReady = 0;
+    INTCONbits.GIE = gie;
+    if (range == freqEvery16) periods *= 16;
+    freqHertz = (float) periods * (_XTAL_FREQ / 4) / cycles;
+    freqPeriodUs = (float) cycles * 4000000.0 / _XTAL_FREQ / periods;     // Not / (_XTAL_FREQ / 4000000), that is 0 below 4MHz
+    freqDutyPercent = range == freqDuty ? (highCycles * 100 + cycles / 2) / cycles : freqNoDuty;
+    if (range == freqDuty && freqHertz > freqUpHertz) freqStart (freqEvery16);
+    else if (range == freqEvery16 && freqHertz < freqDownHertz) freqStart (freqDuty);
+    return 1;
+}
+
+#endif
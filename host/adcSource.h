@@ -0,0 +1,122 @@
+/*
+ * File:   adcSource.h
+ * Name: Test signals for the analog inputs, shared by adcStimulus.c and host/picModel.h
+ *
+ * This runs on a Linux PC, not on the PIC. A signal is given as text, in volts with a 5V
+ * reference, and sourceVolts gives what it is at a time in seconds:
+ *
+ *      const:v                     always v
+ *      ramp:from:to:seconds        from to to in seconds, then starts again
+ *      sine:middle:peak:hz:noise   a sine wave with random noise of noise volts rms added
+ *      step:before:after:seconds   before until seconds, then after
+ *      csv:file[:column]           one reading in volts a line, column counts from 0
+ *      bin:file                    16-bit little endian ADC counts (0 to 1023)
+ *
+ * The files are read a line (or two bytes) each time sourceVolts is called, whatever the
+ * time, so a recording of any length can be played back one reading a conversion. When a
+ * file runs out its last value is kept.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef ADCSOURCE_H
+#define ADCSOURCE_H
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define sourceVref  5.0
+
+typedef struct
+{
+    char kind [8];
+    double a, b, c, d;
+    int column;
+    FILE *file;
+    double last;
+} sourceType;
+
+// The subroutines
+
+static double sourceNoise (void)    // Gaussian with rms 1, Box-Muller
+{
+    double u1 = (rand () + 1.0) / (RAND_MAX + 2.0), u2 = (rand () + 1.0) / (RAND_MAX + 2.0);
+    return sqrt (-2.0 * log (u1)) * cos (2.0 * M_PI * u2);
+}
+
+static int sourceParse (sourceType *s, char *text)     // Returns 0 if the text is not a signal, text is changed
+{
+    char *kind = strtok (text, ":"), *field;
+    double value [4] = { 0, 0, 0, 0 };
+    int n = 0;
+
+    if (!kind) return 0;
+    snprintf (s -> kind, sizeof s -> kind, "%s", kind);
+    if (!strcmp (kind, "csv") || !strcmp (kind, "bin"))
+    {
+        field = strtok (NULL, ":");
+        s -> file = field ? fopen (field, !strcmp (kind, "bin") ? "rb" : "r") : NULL;
+        if (!s -> file)
+        {
+            perror (field ? field : kind);
+            return 0;
+        }
+        field = strtok (NULL, ":");
+        s -> column = field ? atoi (field) : 0;
+        return 1;
+    }
+    while (n < 4 && (field = strtok (NULL, ":"))) value [n ++] = atof (field);
+    s -> a = value [0];
+    s -> b = value [1];
+    s -> c = value [2];
+    s -> d = value [3];
+    return !strcmp (kind, "const") || !strcmp (kind, "ramp") || !strcmp (kind, "sine") || !strcmp (kind, "step");
+}
+
+static double sourceCsv (sourceType *s)    // Next reading from a CSV file, or the last one if it has run out
+{
+    char line [1024], *field;
+    int n;
+    while (fgets (line, sizeof line, s -> file))
+    {
+        field = line;
+        for (n = 0; n < s -> column && field; n ++)
+        {
+            field = strchr (field, ',');
+            if (field) field ++;
+        }
+        if (field && (*field == '-' || *field == '.' || (*field >= '0' && *field <= '9')))
+        {
+            s -> last = atof (field);
+            break;
+        }                           // Otherwise a heading or blank line, try the next one
+    }
+    return s -> last;
+}
+
+static double sourceVolts (sourceType *s, double seconds)
+{
+    unsigned char two [2];
+
+    if (!strcmp (s -> kind, "bin"))     // The middle of the ADC step, so sourceCounts gives the count back
+    {
+        if (fread (two, 1, 2, s -> file) == 2) s -> last = two [0] | (two [1] << 8);
+        return (s -> last + 0.5) * sourceVref / 1024.0;
+    }
+    if (!strcmp (s -> kind, "const")) return s -> a;
+    if (!strcmp (s -> kind, "ramp")) return s -> a + (s -> b - s -> a) * (s -> c > 0 ? fmod (seconds, s -> c) / s -> c : 0);
+    if (!strcmp (s -> kind, "sine")) return s -> a + s -> b * sin (2.0 * M_PI * s -> c * seconds) + s -> d * sourceNoise ();
+    if (!strcmp (s -> kind, "step")) return seconds < s -> c ? s -> a : s -> b;
+    if (!strcmp (s -> kind, "csv")) return sourceCsv (s);
+    return 0;
+}
+
+static int sourceCounts (double volts)     // The 10-bit ADC result for a voltage
+{
+    int result = (int) floor (volts / sourceVref * 1024.0);    // The ADC steps are 5V / 1024
+    return result < 0 ? 0 : result > 1023 ? 1023 : result;
+}
+
+#endif
@@ -0,0 +1,98 @@
+/*
+ * File:   adcStimulus.c
+ * Name: Making ADC input for the MPLAB X simulator from test signals
+ *
+ * This runs on a Linux PC, not on the PIC. Build it with
+ *      gcc -O2 -o adcStimulus adcStimulus.c -lm
+ *
+ * The MPLAB X simulator does not model the analog pins, ADRESH and ADRESL read whatever
+ * is injected into them. This writes the register injection files for them, one value a
+ * line in hex, so ADC_BasicProgramMain.c and VoltMeter_main.c read the same signal every
+ * run. In the Stimulus window add two Register Injection rows, ADRESH from base_h.txt and
+ * ADRESL from base_l.txt, both triggered on demand, so each conversion reads the next line.
+ *
+ *      ./adcStimulus -p 50 -n 20000 -o volts "sine:2.5:2:50:0.01"
+ *
+ * Options:
+ *      -p us       time between conversions in the program, 50us if not given. Sample n
+ *                  is the signal at n x us, i.e. when GO_DONE was set for that conversion
+ *      -n count    conversions to write, 10000 if not given
+ *      -r          right justified results (ADFM = 1), the programs in the book use left
+ *      -s seed     seed for the noise, so a run can be repeated exactly
+ *      -o base     the files are base_h.txt and base_l.txt
+ *
+ * Each signal is one of those in host/adcSource.h, e.g. "const:2.5" or "csv:log.csv:1". The
+ * files are read a line (or two bytes) at a time as they are needed, so a recording of any
+ * length can be played back. If more than one signal is given they go to AN0, AN1 and so
+ * on, and the conversions are written in turn, for a program that scans the channels one
+ * after another.
+ *
+ * A program built for the PC with host/xc.h reads the same signals through PIC_AN0 to
+ * PIC_AN3, at the PIC time each conversion starts rather than on the -p grid here.
+ *
+ * Created on October 19, 2026
+ */
+
+#include "adcSource.h"
+
+#define maxChannels 4               // AN0 to AN3
+
+static sourceType sources [maxChannels];
+static int channels;
+
+int main (int argc, char **argv)
+{
+    double period = 50e-6;
+    long count = 10000, n;
+    int right = 0, arg = 1;
+    const char *base = NULL;
+    char name [1024];
+    FILE *high, *low;
+
+    for (; arg < argc && argv [arg][0] == '-'; arg ++)
+    {
+        if (!strcmp (argv [arg], "-r")) right = 1;
+        else if (arg + 1 < argc && !strcmp (argv [arg], "-p")) period = atof (argv [++ arg]) * 1e-6;
+        else if (arg + 1 < argc && !strcmp (argv [arg], "-n")) count = atol (argv [++ arg]);
+        else if (arg + 1 < argc && !strcmp (argv [arg], "-s")) srand (atoi (argv [++ arg]));
+        else if (arg + 1 < argc && !strcmp (argv [arg], "-o")) base = argv [++ arg];
+        else break;
+    }
+    for (; arg < argc && channels < maxChannels; arg ++)
+        if (!sourceParse (&sources [channels ++], argv [arg]))
+        {
+            fprintf (stderr, "cannot use signal %s\n", argv [arg]);
+            return 2;
+        }
+    if (!base || !channels || period <= 0)
+    {
+        fprintf (stderr, "usage: %s [-p us] [-n count] [-r] [-s seed] -o base signal [signal ...]\n", argv [0]);
+        return 2;
+    }
+    snprintf (name, sizeof name, "%s_h.txt", base);
+    high = fopen (name, "w");
+    snprintf (name, sizeof name, "%s_l.txt", base);
+    low = fopen (name, "w");
+    if (!high || !low)
+    {
+        perror (base);
+        return 1;
+    }
+    for (n = 0; n < count; n ++)
+    {
+        int result = sourceCounts (sourceVolts (&sources [n % channels], n * period));
+        if (right)                  // ADFM = 1, ADRESH holds bits 9:8
+        {
+            fprintf (high, "%02X\n", result >> 8);
+            fprintf (low, "%02X\n", result & 0xFF);
+        }
+        else                        // ADFM = 0, ADRESH holds bits 9:2 and ADRESL bits 7:6 the bottom 2
+        {
+            fprintf (high, "%02X\n", result >> 2);
+            fprintf (low, "%02X\n", (result & 0x03) << 6);
+        }
+    }
+    fclose (high);
+    fclose (low);
+    return 0;
+}
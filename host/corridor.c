@@ -0,0 +1,307 @@
+/*
+ * File:   corridor.c
+ * Name: A road through a row of traffic light junctions, to compare offset plans
+ *
+ * This runs on a Linux PC, not on the PIC. Build it with
+ *      gcc -O2 -pthread -o corridor corridor.c -lm
+ * and with -DredTime=... etc. to try other phase times, as for trafficLightMain.c.
+ *
+ * Each junction is one controller running the plan in trafficPlan_HHWardBook1.h, the same
+ * subroutines the PIC uses, with its own offset. Its green is green for the road. All of
+ * them move on together in steps of virtual time, so an hour of traffic takes well under
+ * a second. A car that leaves a junction cannot get to the next one for -d/-v seconds, so
+ * the steps are done in chunks of that long (travelMs / stepMs steps). Each junction keeps
+ * the cars that left it in a chunk in one of two out lists, one for even chunks and one for
+ * odd. At the start of a chunk every junction takes in the previous chunk's list from the
+ * junction before it, then runs the whole chunk on its own. The junctions can be shared out
+ * between threads with -j, which only have to wait for each other once a chunk, and the
+ * answers are the same whatever the number of threads. One thread is the default. On a
+ * one core PC -n 24 -s takes 0.04s with -j 1 and 0.06s with -j 8 (it was 0.2s and 7.3s
+ * with three waits every step), and -n 256 takes 0.45s either way, so threads only pay
+ * with many junctions on a PC with the cores to run them.
+ *
+ * The cars: they come into the road at random (Poisson) at -q cars an hour and drive at
+ * -v m/s to the next junction -d m away. A car that gets there on green with nobody
+ * waiting goes straight through. Otherwise it stops and joins the queue, and the queue
+ * goes away at one car every 2 seconds while it is green. Each stop counts and the travel
+ * time is from coming into the road to leaving the last junction.
+ *
+ * Plans, all tried unless -p picks one:
+ *      same        every offset 0
+ *      wave        offset = driving time from the first junction, a green wave
+ *      reverse     the green wave for the other direction
+ *      random      random offsets
+ *      list        the offsets given with -o, in ms
+ *
+ * Each controller's clock is wrong by up to -drift ppm, as a PIC's is. With -s each one
+ * gets a sync pulse every cycle (the TRAFFIC_SYNC input of trafficLightMain.c) that puts
+ * its offset right again.
+ *
+ * Options:
+ *      -n junctions    8 if not given              -d metres   between junctions, 300
+ *      -v m/s          13.9 (50km/h)               -q cars     an hour, 600
+ *      -t seconds      of traffic, 3600            -j threads  1
+ *      -drift ppm      500                         -s          sync pulses on
+ *      -p plan         one of the plans above      -o a,b,c    offsets for the list plan
+ *
+ * Each plan prints one line of key=value so host/sweep.c can collect them, e.g.
+ *      ./corridor -n 24 -s
+ *      plan=wave junctions=24 cars=507 travelTime=526.6 stopsPerCar=0.83 freeTime=518.0 lost=0
+ *
+ * Created on October 19, 2026
+ */
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../trafficPlan_HHWardBook1.h"
+
+#define stepMs      100             // Virtual time moved on each step
+#define headwayMs   2000            // Time between cars leaving a queue
+#define maxCars     4096            // Cars on the way to one junction at once, must be a power of 2
+#define maxJunctions 256
+
+typedef struct
+{
+    long long arrive;               // ms when it gets to the junction
+    long long entered;              // ms when it came into the road
+    int stops;
+    int stopped;                    // 1 while it is in the queue
+} carType;
+
+typedef struct
+{
+    unsigned int offset;            // The plan
+    double position;                // ms since red came on, as the controller sees it
+    double rate;                    // How fast its clock runs, 1 +/- drift
+    int green;
+    carType cars [maxCars];         // Cars on the way to this junction or waiting at it, in order
+    int head, tail;
+    long long nextLeave;            // Soonest the next car from the queue can go
+    carType out [2] [maxCars];      // Cars that left in even and odd chunks, for the next junction
+    int outCount [2];
+    int lost;                       // Cars that did not fit
+} junctionType;
+
+static junctionType *junctions;
+static int junctionCount = 8, threadCount, syncPulses;
+static double spacing = 300.0, speed = 13.9, carsPerHour = 600.0, seconds = 3600.0, driftPpm = 500.0;
+static long long travelMs, chunkMs;
+static pthread_barrier_t barrier;
+static unsigned int entrySeed;
+static long long nextEntry;
+
+static long long doneCars, doneStops, doneTravel;   // Only the last junction's thread writes these
+
+static double randomUnit (unsigned int *seed)       // 0 to just under 1
+{
+    return rand_r (seed) / (RAND_MAX + 1.0);
+}
+
+static void addCar (junctionType *junction, const carType *car)
+{
+    if (junction -> tail - junction -> head >= maxCars)
+    {
+        junction -> lost ++;
+        return;
+    }
+    junction -> cars [junction -> tail ++ & (maxCars - 1)] = *car;
+}
+
+static void leave (junctionType *junction, int index, carType *car, long long now, int chunk)
+{
+    if (index == junctionCount - 1)             // Out of the road
+    {
+        doneCars ++;
+        doneStops += car -> stops;
+        doneTravel += now - car -> entered;
+        return;
+    }
+    car -> arrive = now + travelMs;
+    car -> stopped = 0;
+    junction -> out [chunk & 1] [junction -> outCount [chunk & 1] ++] = *car;
+}
+
+static void stepJunction (int index, long long now, int chunk)  // The controller and the cars at its stop line for one step
+{
+    junctionType *junction = &junctions [index];
+    carType *car;
+    long long pulse;
+
+    if (syncPulses && now / trafficCycle != (now + stepMs) / trafficCycle)     // A sync pulse comes during this step
+    {
+        pulse = (now + stepMs) / trafficCycle * trafficCycle;
+        junction -> position = (double) trafficStartPosition (junction -> offset) - (pulse - now);    // So it is right at the pulse
+        if (junction -> position < 0) junction -> position += trafficCycle;
+    }
+    junction -> green = trafficPhaseAt ((unsigned int) junction -> position) == greenPhase;
+    junction -> position += stepMs * junction -> rate;
+    while (junction -> position >= trafficCycle) junction -> position -= trafficCycle;
+
+    while (junction -> head != junction -> tail)
+    {
+        car = &junction -> cars [junction -> head & (maxCars - 1)];
+        if (car -> arrive > now) break;         // Not there yet, nor is anyone behind it
+        if (junction -> green && !car -> stopped)
+        {
+            junction -> head ++;                // Straight through
+            leave (junction, index, car, now, chunk);
+            continue;
+        }
+        if (junction -> green && now >= junction -> nextLeave)
+        {
+            junction -> head ++;                // Off the front of the queue
+            junction -> nextLeave = now + headwayMs;
+            leave (junction, index, car, now, chunk);
+            continue;
+        }
+        break;                                  // It has to wait, and so do the cars behind it
+    }
+    for (int n = junction -> head; n != junction -> tail; n ++)
+    {
+        car = &junction -> cars [n & (maxCars - 1)];
+        if (car -> arrive > now) break;
+        if (!car -> stopped)
+        {
+            car -> stopped = 1;
+            car -> stops ++;
+        }
+    }
+}
+
+static void takeIn (int index, long long last, int chunk)    // Cars from the junction before, or new ones for the first
+{
+    junctionType *before;
+    carType car;
+    int n;
+    junctions [index].outCount [chunk & 1] = 0;
+    if (index)
+    {
+        before = &junctions [index - 1];
+        if (chunk) for (n = 0; n < before -> outCount [(chunk - 1) & 1]; n ++) addCar (&junctions [index], &before -> out [(chunk - 1) & 1] [n]);
+        return;
+    }
+    while (nextEntry <= last)                   // Up to the last step of this chunk
+    {
+        memset (&car, 0, sizeof car);
+        car.entered = nextEntry;
+        car.arrive = nextEntry + travelMs;
+        addCar (&junctions [0], &car);
+        nextEntry += (long long) (-log (1.0 - randomUnit (&entrySeed)) * 3600000.0 / carsPerHour) + 1;
+    }
+}
+
+static void *worker (void *number)
+{
+    int thread = (int) (long) number, first, last, index, chunk;
+    long long end = (long long) (seconds * 1000.0), start, stop, now;
+    first = junctionCount * thread / threadCount;
+    last = junctionCount * (thread + 1) / threadCount;
+    for (chunk = 0, start = 0; start < end; chunk ++, start += chunkMs)
+    {
+        stop = start + chunkMs < end ? start + chunkMs : end;
+        for (index = first; index < last; index ++)
+        {
+            takeIn (index, stop - 1 - (stop - 1 - start) % stepMs, chunk);
+            for (now = start; now < stop; now += stepMs) stepJunction (index, now, chunk);
+        }
+        if (threadCount > 1) pthread_barrier_wait (&barrier);   // Before anyone reads this chunk's out lists
+    }
+    return NULL;
+}
+
+static void runPlan (const char *name, const unsigned int *offsets)
+{
+    pthread_t ids [maxJunctions];
+    unsigned int driftSeed = 7;
+    int n, lost = 0;
+
+    memset (junctions, 0, junctionCount * sizeof (junctionType));
+    for (n = 0; n < junctionCount; n ++)
+    {
+        junctions [n].offset = offsets [n] % trafficCycle;
+        junctions [n].position = trafficStartPosition (junctions [n].offset);
+        junctions [n].rate = 1.0 + (randomUnit (&driftSeed) * 2.0 - 1.0) * driftPpm / 1e6;
+    }
+    nextEntry = 0;
+    entrySeed = 1;                              // The same cars for every plan
+    doneCars = doneStops = doneTravel = 0;
+    pthread_barrier_init (&barrier, NULL, threadCount);
+    for (n = 0; n < threadCount; n ++) pthread_create (&ids [n], NULL, worker, (void *) (long) n);
+    for (n = 0; n < threadCount; n ++) pthread_join (ids [n], NULL);
+    pthread_barrier_destroy (&barrier);
+    for (n = 0; n < junctionCount; n ++) lost += junctions [n].lost;
+
+    printf ("plan=%s junctions=%d cars=%lld travelTime=%.1f stopsPerCar=%.2f freeTime=%.1f lost=%d\n", name, junctionCount,
+            doneCars, doneCars ? doneTravel / 1000.0 / doneCars : 0.0, doneCars ? (double) doneStops / doneCars : 0.0,
+            travelMs * junctionCount / 1000.0, lost);
+}
+
+int main (int argc, char **argv)
+{
+    static unsigned int offsets [maxJunctions], list [maxJunctions];
+    const char *plan = NULL;
+    unsigned int randomSeed = 3;
+    int arg, n, listCount = 0;
+    char *value, *save;
+
+    threadCount = 1;
+    for (arg = 1; arg < argc; arg ++)
+    {
+        if (!strcmp (argv [arg], "-s")) syncPulses = 1;
+        else if (arg + 1 >= argc) break;
+        else if (!strcmp (argv [arg], "-n")) junctionCount = atoi (argv [++ arg]);
+        else if (!strcmp (argv [arg], "-d")) spacing = atof (argv [++ arg]);
+        else if (!strcmp (argv [arg], "-v")) speed = atof (argv [++ arg]);
+        else if (!strcmp (argv [arg], "-q")) carsPerHour = atof (argv [++ arg]);
+        else if (!strcmp (argv [arg], "-t")) seconds = atof (argv [++ arg]);
+        else if (!strcmp (argv [arg], "-j")) threadCount = atoi (argv [++ arg]);
+        else if (!strcmp (argv [arg], "-drift")) driftPpm = atof (argv [++ arg]);
+        else if (!strcmp (argv [arg], "-p")) plan = argv [++ arg];
+        else if (!strcmp (argv [arg], "-o"))
+            for (value = strtok_r (argv [++ arg], ",", &save); value && listCount < maxJunctions; value = strtok_r (NULL, ",", &save))
+                list [listCount ++] = atoi (value);
+        else break;
+    }
+    if (arg < argc || junctionCount < 1 || junctionCount > maxJunctions || speed <= 0.0 || carsPerHour <= 0.0)
+    {
+        fprintf (stderr, "usage: %s [-n junctions] [-d metres] [-v m/s] [-q cars/hour] [-t seconds] [-j threads]\n"
+                         "          [-drift ppm] [-s] [-p same|wave|reverse|random|list] [-o ms,ms,...]\n", argv [0]);
+        return 2;
+    }
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > junctionCount) threadCount = junctionCount;
+    travelMs = (long long) (spacing / speed * 1000.0 + 0.5);
+    chunkMs = travelMs >= stepMs ? travelMs / stepMs * stepMs : stepMs;
+    junctions = malloc (junctionCount * sizeof (junctionType));
+
+    if (!plan || !strcmp (plan, "same"))
+    {
+        memset (offsets, 0, sizeof offsets);
+        runPlan ("same", offsets);
+    }
+    if (!plan || !strcmp (plan, "wave"))
+    {
+        for (n = 0; n < junctionCount; n ++) offsets [n] = (unsigned int) ((n * travelMs) % trafficCycle);
+        runPlan ("wave", offsets);
+    }
+    if (!plan || !strcmp (plan, "reverse"))
+    {
+        for (n = 0; n < junctionCount; n ++) offsets [n] = (unsigned int) (((junctionCount - 1 - n) * travelMs) % trafficCycle);
+        runPlan ("reverse", offsets);
+    }
+    if (!plan || !strcmp (plan, "random"))
+    {
+        for (n = 0; n < junctionCount; n ++) offsets [n] = rand_r (&randomSeed) % trafficCycle;
+        runPlan ("random", offsets);
+    }
+    if ((!plan && listCount) || (plan && !strcmp (plan, "list")))
+    {
+        for (n = 0; n < junctionCount; n ++) offsets [n] = listCount ? list [n % listCount] : 0;
+        runPlan ("list", offsets);
+    }
+    free (junctions);
+    return 0;
+}
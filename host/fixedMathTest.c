@@ -0,0 +1,103 @@
+/*
+ * File:   fixedMathTest.c
+ * Name: Checking fixedMath_HHWardBook1.h against long arithmetic for every input
+ *
+ * This runs on a Linux PC, not on the PIC. Build and run it from the top folder with
+ *      gcc -O2 -pthread -o fixedMathTest host/fixedMathTest.c && ./fixedMathTest
+ *
+ * int is 16 bits in XC8 and 32 on the PC, so the subroutines are built here with int
+ * turned into short and __uint24 into unsigned long, which makes them wrap and overflow
+ * as they do on the PIC. Every one is then checked against the same sum done in long
+ * arithmetic:
+ *
+ *      mul16, mulHigh16, mulQ8, mulQ15,
+ *      addSaturate, addSaturateU           every pair of 16-bit inputs
+ *      mul16x8                             every 16-bit a with every 8-bit b
+ *      divideBy                            every 16-bit x with every d from 2 to 65535
+ *
+ * That is about 30 billion checks, a couple of minutes on one core, so the work is shared
+ * out over the PC's cores by the first input. It prints the first few answers that are
+ * wrong, then one line of key=value, and gives exit status 1 if any were wrong.
+ *
+ * Created on October 19, 2026
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#define __uint24 unsigned long
+#define int short                       // XC8's 16-bit int, unsigned int becomes unsigned short
+#include "../fixedMath_HHWardBook1.h"
+#undef int
+
+#define maxReported 10
+
+static atomic_long failures, checks;
+static atomic_int nextFirst;
+
+static long clamp16 (long x)            // What the signed subroutines hold an answer to
+{
+    return x > 32767 ? 32767 : x < -32768 ? -32768 : x;
+}
+
+static void fail (const char *name, long a, long b, long got, long want)
+{
+    if (atomic_fetch_add (&failures, 1) < maxReported)
+        printf ("FAIL %s (%ld, %ld) = %ld, should be %ld\n", name, a, b, got, want);
+}
+
+static void checkPairs (long a)         // Every second input with this first one
+{
+    long b, product;
+    short sa = (short) a, sb;
+    for (b = 0; b < 65536; b ++)
+    {
+        sb = (short) b;
+        product = (long) a * b;
+        if (mul16 (a, b) != (unsigned long) product) fail ("mul16", a, b, mul16 (a, b), product);
+        if (mulHigh16 (a, b) != product >> 16) fail ("mulHigh16", a, b, mulHigh16 (a, b), product >> 16);
+        product = (long) sa * sb;
+        if (mulQ8 (sa, sb) != clamp16 (product / 256)) fail ("mulQ8", sa, sb, mulQ8 (sa, sb), clamp16 (product / 256));
+        if (mulQ15 (sa, sb) != clamp16 (product / 32768)) fail ("mulQ15", sa, sb, mulQ15 (sa, sb), clamp16 (product / 32768));
+        if (addSaturate (sa, sb) != clamp16 ((long) sa + sb)) fail ("addSaturate", sa, sb, addSaturate (sa, sb), clamp16 ((long) sa + sb));
+        if (addSaturateU (a, b) != (a + b > 65535 ? 65535 : a + b)) fail ("addSaturateU", a, b, addSaturateU (a, b), a + b > 65535 ? 65535 : a + b);
+        if (b < 256 && mul16x8 (a, b) != (unsigned long) (a * b)) fail ("mul16x8", a, b, mul16x8 (a, b), a * b);
+    }
+    atomic_fetch_add (&checks, 6 * 65536L + 256);
+}
+
+static void checkDivide (long d)        // Every x divided by this d
+{
+    long x;
+    unsigned short reciprocal = fixedReciprocal (d);
+    for (x = 0; x < 65536; x ++)
+        if (divideBy (x, d, reciprocal) != x / d) fail ("divideBy", x, d, divideBy (x, d, reciprocal), x / d);
+    atomic_fetch_add (&checks, 65536);
+}
+
+static void *worker (void *unused)
+{
+    long first;
+    (void) unused;
+    while ((first = atomic_fetch_add (&nextFirst, 1)) < 65536)
+    {
+        checkPairs (first);
+        if (first >= 2) checkDivide (first);
+    }
+    return NULL;
+}
+
+int main (void)
+{
+    int threads = sysconf (_SC_NPROCESSORS_ONLN), n;
+    pthread_t ids [256];
+
+    if (threads < 1) threads = 1;
+    if (threads > 256) threads = 256;
+    for (n = 0; n < threads; n ++) pthread_create (&ids [n], NULL, worker, NULL);
+    for (n = 0; n < threads; n ++) pthread_join (ids [n], NULL);
+    printf ("threads=%d checks=%ld failures=%ld\n", threads, (long) checks, (long) failures);
+    return failures != 0;
+}
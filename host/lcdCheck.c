@@ -0,0 +1,127 @@
+/*
+ * File:   lcdCheck.c
+ * Name: Checking lcd4Bit_HHWardBook1.h against the LCD model
+ *
+ * This runs on a Linux PC, not on the PIC. It builds the real LCD subroutines with
+ * host/xc.h and runs them against host/lcdModel.c. Build and run it from the top folder,
+ * once for each way the LCD can be connected:
+ *      gcc -O2 -DPIN_HOST_BACKEND -Ihost -o lcdCheck host/lcdCheck.c host/lcdModel.c -lm && ./lcdCheck
+ *      gcc -O2 -DPIN_HOST_BACKEND -DLCD_SPI -Ihost -o lcdCheck host/lcdCheck.c host/lcdModel.c -lm && ./lcdCheck
+ *
+ * and once more for each other size of LCD, e.g.
+ *      gcc -O2 -DPIN_HOST_BACKEND -DlcdColumns=20 -DlcdRows=4 -Ihost -o lcdCheck host/lcdCheck.c host/lcdModel.c -lm && ./lcdCheck
+ * with 16 x 4, 40 x 2 and 16 x 1 as well.
+ *
+ * It checks that setUpTheLCD and setUpTheLCDQuick (after a 32ms wait) leave the LCD in
+ * 4-bit mode with the right number of lines and never send a nibble while it is busy,
+ * and measures the instruction cycles each nibble costs on the pins or the MSSP. Then it
+ * checks the DDRAM address lcdGotoXY sets at the first, second and last column of every
+ * line, and that a row or column off the LCD goes to the nearest character on it. Last,
+ * writeString started 3 characters from the end of line 1 with a string longer than the
+ * LCD must carry on at the start of each line and stop after the last one, leaving every
+ * other address alone. It prints one line of key=value and gives exit
+ * status 1 if anything is wrong.
+ *
+ * Created on October 19, 2026
+ */
+
+#include <xc.h>
+#include <stdio.h>
+#include <string.h>
+#include "lcdModel.h"
+
+#define _XTAL_FREQ 8000000
+#include "../lcd4Bit_HHWardBook1.h"
+
+static int failures;
+
+static void check (int good, const char *what)
+{
+    if (good) return;
+    printf ("FAIL %s\n", what);
+    failures ++;
+}
+
+static unsigned char rowAddress (unsigned char row)    // Where each line starts, from the data sheet not lcdRowStart
+{
+    const unsigned char start [4] = {0x00, 0x40, lcdColumns, 0x40 + lcdColumns};
+    return start [row];
+}
+
+static void checkSetUp (const char *name)
+{
+    char what [80];
+    snprintf (what, sizeof what, "%s: 4-bit mode", name);
+    check (lcdModelFourBit, what);
+    snprintf (what, sizeof what, "%s: number of lines", name);
+    check (lcdModelTwoLines == (lcdRows > 1), what);
+    snprintf (what, sizeof what, "%s: nothing sent while the LCD was busy", name);
+    check (lcdModelBusyErrors == 0, what);
+    snprintf (what, sizeof what, "%s: cursor at home", name);
+    check (lcdModelAddress == 0 && !lcdModelCgram, what);
+}
+
+int main (void)
+{
+    unsigned long long tcy;
+    long nibbles;
+    int n, row, col;
+    char what [80];
+    char words [lcdColumns * lcdRows + 11];
+    unsigned char expected [sizeof lcdModelDdram];
+    const unsigned char columns [3] = {0, 1, lcdColumns - 1};
+
+    lcdModelReset ();                   // The book's set up, with its own power on wait
+    setUpTheLCD ();
+    checkSetUp ("setUpTheLCD");
+
+    lcdModelReset ();
+    __delay_ms(32);                     // setUpTheLCDQuick leaves the power on wait to the program
+    setUpTheLCDQuick ();
+    checkSetUp ("setUpTheLCDQuick");
+
+    tcy = lcdModelBusTcy;               // The cost of each nibble, without the delays
+    nibbles = lcdModelNibbles;
+    for (n = 0; n < 32; n ++)
+    {
+        lcdData = 'A' + n % 26;
+        lcdOutQuick ();
+    }
+    check (lcdModelBusyErrors == 0, "lcdOutQuick: nothing sent while the LCD was busy");
+    check (lcdModelDdram [0] == 'A' && lcdModelDdram [25] == 'Z', "lcdOutQuick: characters in the DDRAM");
+
+    for (row = 0; row < lcdRows; row ++)     // lcdGotoXY at the edges of every line
+    {
+        for (n = 0; n < 3; n ++)
+        {
+            lcdGotoXY (columns [n], row);
+            snprintf (what, sizeof what, "lcdGotoXY (%d, %d): DDRAM address", columns [n], row);
+            check (lcdModelAddress == rowAddress (row) + columns [n] && !lcdModelCgram, what);
+        }
+    }
+
+    lcdGotoXY (lcdColumns + 5, lcdRows + 2);    // Off the LCD, clamped to the last character
+    check (lcdModelAddress == rowAddress (lcdRows - 1) + lcdColumns - 1 && cursorCol == lcdColumns - 1 && cursorRow == lcdRows - 1,
+           "lcdGotoXY past the last row and column: clamped to the last character");
+    lcdGotoXY (255, 0);
+    check (lcdModelAddress == lcdColumns - 1, "lcdGotoXY (255, 0): clamped to the end of line 1");
+
+    for (n = 0; n < (int) sizeof words - 1; n ++) words [n] = 'a' + n % 26;   // writeString wrapping and stopping
+    words [n] = 0;
+    memset (expected, ' ', sizeof expected);
+    n = 0;
+    for (row = 0; row < lcdRows; row ++)
+    {
+        for (col = row ? 0 : lcdColumns - 3; col < lcdColumns; col ++) expected [rowAddress (row) + col] = words [n ++];
+    }
+    clearTheScreen ();
+    lcdGotoXY (lcdColumns - 3, 0);
+    writeString (words);
+    check (memcmp (lcdModelDdram, expected, sizeof expected) == 0, "writeString: characters wrap to each line and stop after the last");
+    check (cursorRow == lcdRows - 1 && cursorCol == lcdColumns, "writeString: cursor left after the end of the last line");
+    check (lcdModelBusyErrors == 0, "writeString: nothing sent while the LCD was busy");
+
+    printf ("transport=%s columns=%d rows=%d tcyPerNibble=%.1f busyErrors=%ld failures=%d\n", lcdModelSpi ? "spi" : "direct",
+            lcdColumns, lcdRows, (double) (lcdModelBusTcy - tcy) / (lcdModelNibbles - nibbles), lcdModelBusyErrors, failures);
+    return failures != 0;
+}
@@ -0,0 +1,184 @@
+/*
+ * File:   lcdModel.c
+ * Name: hostPinWrite, hostPinRead and hostDelayNs driving an HD44780 model, see lcdModel.h
+ *
+ * Created on October 19, 2026
+ */
+
+#include <string.h>
+#include "lcdModel.h"
+#include "pinsVcd.h"
+
+#define powerOnNs   15000000ULL     // The LCD ignores everything for 15ms after power on
+#define shortNs     37000ULL        // Most instructions and all data
+#define longNs      1520000ULL      // Clear and home
+
+extern volatile unsigned char SSPBUF;   // From host/xc.h in the program
+
+unsigned char lcdModelDdram [128];
+unsigned char lcdModelAddress;
+int lcdModelFourBit, lcdModelTwoLines, lcdModelCgram;
+long lcdModelNibbles, lcdModelBusyErrors;
+unsigned long long lcdModelBusTcy;
+int lcdModelSpi;
+
+static unsigned char latch [5];         // PORTA to PORTE
+static unsigned char inputs;            // What is on the LCD's pins, PORTB or the 595 outputs
+static unsigned char firstNibble;       // The high nibble in 4-bit mode, while waiting for the low one
+static int haveFirst, resetNibbles, increment;
+static unsigned long long timeNs, readyNs, delayNs;  // delayNs is all the delays so far
+
+void lcdModelReset (void)
+{
+    memset (lcdModelDdram, ' ', sizeof lcdModelDdram);
+    memset (latch, 0, sizeof latch);
+    lcdModelAddress = 0;
+    lcdModelFourBit = 0;
+    lcdModelTwoLines = 0;
+    lcdModelCgram = 0;
+    lcdModelNibbles = 0;
+    lcdModelBusyErrors = 0;
+    lcdModelBusTcy = 0;
+    lcdModelSpi = 0;
+    inputs = 0;
+    haveFirst = 0;
+    resetNibbles = 0;
+    increment = 1;
+    timeNs = 0;
+    delayNs = 0;
+    readyNs = powerOnNs;
+}
+
+static void moveAddress (int step)      // The address counter goes round the DDRAM the way the LCD's does
+{
+    int address = lcdModelAddress + step;
+    if (lcdModelTwoLines)
+    {
+        if (lcdModelAddress == 0x27 && step > 0) address = 0x40;
+        else if (lcdModelAddress == 0x67 && step > 0) address = 0x00;
+        else if (lcdModelAddress == 0x40 && step < 0) address = 0x27;
+        else if (lcdModelAddress == 0x00 && step < 0) address = 0x67;
+    }
+    else if (address > 0x4F) address = 0x00;
+    else if (address < 0) address = 0x4F;
+    lcdModelAddress = address;
+}
+
+static void instruction (unsigned char code)
+{
+    readyNs = timeNs + shortNs;
+    if (code >= 0x80)
+    {
+        lcdModelAddress = code & 0x7F;
+        lcdModelCgram = 0;
+    }
+    else if (code >= 0x40)
+    {
+        lcdModelAddress = code & 0x3F;
+        lcdModelCgram = 1;
+    }
+    else if (code >= 0x20)
+    {
+        lcdModelFourBit = !(code & 0x10);
+        lcdModelTwoLines = (code & 0x08) != 0;
+    }
+    else if (code >= 0x10)
+    {
+        if (!(code & 0x08)) moveAddress (code & 0x04 ? 1 : -1);     // Cursor shift, a display shift does not move it
+    }
+    else if (code >= 0x04) increment = (code & 0x02) != 0;
+    else if (code >= 0x02)
+    {
+        lcdModelAddress = 0;
+        lcdModelCgram = 0;
+        readyNs = timeNs + longNs;
+    }
+    else if (code == 0x01)
+    {
+        memset (lcdModelDdram, ' ', sizeof lcdModelDdram);
+        lcdModelAddress = 0;
+        lcdModelCgram = 0;
+        increment = 1;
+        readyNs = timeNs + longNs;
+    }
+}
+
+static void data (unsigned char info)
+{
+    readyNs = timeNs + shortNs;
+    if (lcdModelCgram)
+    {
+        lcdModelAddress = (lcdModelAddress + 1) & 0x3F;    // The CGRAM is not kept, only the address moves
+        return;
+    }
+    lcdModelDdram [lcdModelAddress] = info;
+    moveAddress (increment ? 1 : -1);
+}
+
+static void nibble (unsigned char pins)     // E has just gone low
+{
+    unsigned char value = pins & 0x0F, rs = pins & 0x10;
+    lcdModelNibbles ++;
+    if (timeNs < readyNs) lcdModelBusyErrors ++;
+    if (!lcdModelFourBit)                   // 8-bit mode, D0 to D3 are not connected so they read as 0
+    {
+        instruction (value << 4);
+        resetNibbles ++;
+        if (resetNibbles == 1) readyNs = timeNs + 4100000ULL;
+        else if (resetNibbles == 2) readyNs = timeNs + 100000ULL;
+        haveFirst = 0;
+        return;
+    }
+    if (!haveFirst)
+    {
+        firstNibble = value;
+        haveFirst = 1;
+        readyNs = timeNs;                   // The LCD is ready for the second nibble straight away
+        return;
+    }
+    haveFirst = 0;
+    if (rs) data (firstNibble << 4 | value);
+    else instruction (firstNibble << 4 | value);
+}
+
+static void lcdPins (unsigned char pins)    // New levels on the LCD's pins
+{
+    if ((inputs & 0x20) && !(pins & 0x20)) nibble (pins);
+    inputs = pins;
+}
+
+void hostPinWrite (char port, unsigned char mask, unsigned char value)
+{
+    int index = port - 'A';
+    unsigned char old;
+    if (index < 0 || index > 4) return;
+    lcdModelBusTcy += mask == 0xFF || (mask & (mask - 1)) ? 2 : 1;    // A whole port or a group is MOVFF, one pin BSF/BCF
+    timeNs = lcdModelBusTcy * hostTcyNs + delayNs;
+    old = latch [index];
+    latch [index] = (old & ~mask) | (value & mask);
+    if (port == 'C' && !(old & 0x01) && (latch [index] & 0x01))     // The 595 latch, RCLK on RC0
+    {
+        lcdModelSpi = 1;
+        lcdModelBusTcy += 11;               // The transfer before it: MOVFF to SSPBUF, 8 bits, MOVF SSPBUF
+        timeNs = lcdModelBusTcy * hostTcyNs + delayNs;
+        lcdPins (SSPBUF);
+    }
+    if (port == 'B' && !lcdModelSpi) lcdPins (latch [index]);
+}
+
+unsigned char hostPinRead (char port)
+{
+    int index = port - 'A';
+    return index >= 0 && index <= 4 ? latch [index] : 0;
+}
+
+void hostDelayNs (unsigned long long ns)
+{
+    delayNs += ns;
+    timeNs = lcdModelBusTcy * hostTcyNs + delayNs;
+}
+
+unsigned long long hostTimeNs (void)
+{
+    return timeNs;
+}
@@ -0,0 +1,42 @@
+/*
+ * File:   lcdModel.h
+ * Name: A model of an HD44780 LCD, on PORTB or behind a 74HC595, for PC builds
+ *
+ * This runs on a Linux PC, not on the PIC. lcdModel.c supplies hostPinWrite, hostPinRead
+ * and hostDelayNs (see pinsVcd.h) for a program built with PIN_HOST_BACKEND and host/xc.h,
+ * and feeds what the program does with the pins into a model of the LCD:
+ *
+ *      Direct      RB0 to RB3 = D4 to D7, RB4 = RS, RB5 = E, as lcd4Bit_HHWardBook1.h
+ *      LCD_SPI     a rising edge on RC0 copies the last byte written to SSPBUF to the
+ *                  595 outputs, which are wired the same way as PORTB
+ *
+ * The LCD takes a nibble when E goes low. It starts in 8-bit mode, where every nibble is
+ * a whole instruction, until a function set with DL = 0 puts it in 4-bit mode. Every
+ * nibble that comes before the LCD has finished the last instruction counts as a busy
+ * error: 4.1ms after the first 0x3, 100us after the second, 1.52ms after clear and home
+ * and 37us after everything else. The DDRAM, the address counter and the line wrapping
+ * follow the data sheet (0x00 to 0x27 and 0x40 to 0x67 with two lines).
+ *
+ * The time is counted in instruction cycles from what the program does with the pins:
+ * a whole port write is a MOVFF (2 Tcy), a single pin a BSF or BCF (1 Tcy), and each
+ * byte through the MSSP is MOVFF to SSPBUF, 8 Tcy shifting at FOSC/4 and MOVF SSPBUF
+ * (11 Tcy) before its latch pulse. The delays add their own time on top.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef LCDMODEL_H
+#define LCDMODEL_H
+
+extern unsigned char lcdModelDdram [128];   // What has been written to each DDRAM address
+extern unsigned char lcdModelAddress;       // The address counter
+extern int lcdModelFourBit, lcdModelTwoLines;
+extern int lcdModelCgram;                   // 1 after a set CGRAM address, until a set DDRAM address
+extern long lcdModelNibbles;                // Nibbles the LCD has taken
+extern long lcdModelBusyErrors;             // Nibbles that came while the LCD was busy
+extern unsigned long long lcdModelBusTcy;   // Instruction cycles spent on the pins and the MSSP, not the delays
+extern int lcdModelSpi;                     // 1 once the 595 latch has been pulsed
+
+void lcdModelReset (void);                  // Power on, with the time at 0
+
+#endif
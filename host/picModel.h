@@ -0,0 +1,637 @@
+/*
+ * File:   picModel.h
+ * Name: The PIC's timers, CCP, interrupts, EUSART, ADC and EEPROM for PC builds, included by host/xc.h
+ *
+ * This runs on a Linux PC, not on the PIC. The registers in hostSfrs (see xc.h) are
+ * reached through hostTouch, so every read or write of one is seen here. Each access is
+ * one instruction cycle of PIC time, the pins are one more each (pinsVcd.c) and the
+ * delays are what they say. Everything else the C does takes no PIC time at all, so a
+ * time measured on the PC is the least the PIC could take, never more.
+ *
+ * What moves on with the PIC time:
+ *
+ *      Timer 0         8 or 16-bit, the prescaler, TMR0IF. TMR0H is written to the timer
+ *                      when TMR0L is written and reading TMR0L copies the top byte into it
+ *      Timer 1, 3      the prescaler, TMRxIF, RD16 as for Timer 0. Only the instruction
+ *                      clock, not T1OSC or an external clock
+ *      CCP1            capture (CCP1M = 0100 to 0111) of a square wave on RC2 given by
+ *                      PIC_CCP1 as hz:duty, e.g. "1000:25" for 1kHz high for 25% of each
+ *                      period, 50% if the duty is left out. Timer 1, or Timer 3 if T3CCP2
+ *                      is 1, is copied into CCPR1 at the edge and CCP1IF set. A capture
+ *                      before CCPR1 is read writes over it, as on the PIC
+ *      CCP2            compare with special event (CCP2M = 1011): Timer 3, or Timer 1 if
+ *                      T3CCP2 and T3CCP1 are 0, goes back to 0 at CCPR2 and CCP2IF is set
+ *      EUSART TX       TXREG to the shift register, 10 bits a byte at the SPBRG baud rate,
+ *                      TXIF and TRMT. The bytes go to the file PIC_UART if it is set
+ *      ADC             setting GO, or a CCP2 special event with ADON set, waits the ACQT
+ *                      acquisition and 11 TAD, then fills ADRESH and ADRESL as ADFM says,
+ *                      clears GO and sets ADIF. AN0 to AN3 read the signals in PIC_AN0 to
+ *                      PIC_AN3, written as for host/adcSource.h, at the PIC time the
+ *                      conversion starts. A channel with no signal, or above AN3, reads 0V
+ *      Data EEPROM     RD reads EEDATA at once. WR after EECON2 = 0x55 then 0xAA with WREN
+ *                      set writes the byte in 4ms, then clears WR and sets EEIF. It starts
+ *                      erased (0xFF), or from the file PIC_EEPROM, which is written back
+ *                      at the end so the next run starts from it as after a switch off
+ *      Interrupts      when GIE is set and an enabled flag (PEIE as well for PIR1 and
+ *                      PIR2) is up the program's isr is called, with GIE off while it
+ *                      runs. Going in and out costs PIC_ISR_TCY cycles, 30 if not set.
+ *                      The program gets one register access in between two of them, as
+ *                      the PIC runs one instruction, so a flood of them slows it right down
+ *
+ * The hold capacitor charges towards the selected input from the end of the last conversion
+ * or the change of channel, whichever was later, with a time constant of 25pF times
+ * PIC_ADC_OHMS (the source resistance, 2500 if not set) and 3000 ohms inside the PIC, so a
+ * short acquisition after reading another channel reads low or high as it does on the PIC.
+ * A TAD under the 0.7us the data sheet allows adds noise, more the shorter it is.
+ *
+ * A write is only seen when it changes the register, as it is noticed on the next
+ * access. Writing TMRxH and then TMRxL is always taken as writing the timer, even when
+ * the value is the same as it already has, and a TMRxL write takes the TMRxH buffer as it
+ * was before, even when writing TMRxH did not change it.
+ *
+ * A loop that touches no register or pin, such as while (scopeState != scopeFrozen);,
+ * does not move the time on. A timer signal every 1ms of the PC's processor time looks
+ * for that: if the PIC time has not moved since the last one it is moved on to the next
+ * thing that can happen, up to 1ms of PIC time after the first interrupt it runs, so the
+ * loop sees what the interrupts did. With the interrupts off nothing can ever change, so
+ * after a whole second of processor time, long enough for any sum the program is working
+ * out to finish, it is stopped there as if its time was up.
+ *
+ * With PIC_STATS set, one line of key=value goes to stderr at the end: the PIC time, the
+ * number of interrupts, the time spent in them and that as a fraction of the run, the
+ * bytes sent by the EUSART, the ADC conversions and the EEPROM bytes written.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef PICMODEL_H
+#define PICMODEL_H
+
+#include "adcSource.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#define hostOscNs       125ULL      // One oscillator cycle at 8MHz, a quarter of Tcy
+#define hostIdleNs      100000000ULL    // Most PIC time moved on in one go when the program is idle
+#define hostNever       (~0ULL)
+#define hostTimerCount  4           // Timer 0 to 3, Timer 2 is not modelled
+#define hostAdcInputs   4           // AN0 to AN3 can have a signal
+#define hostHoldFarads  25e-12      // The hold capacitor
+#define hostAdcOhms     3000.0      // Inside the PIC, from the pin to the hold capacitor
+#define hostEepromSize  1024
+#define hostEepromNs    4000000ULL  // One byte written
+
+typedef struct
+{
+    int on;                         // Counting instruction cycles
+    unsigned long long tickNs;      // One count, Tcy x the prescale
+    unsigned long long baseNs;      // When it held baseCount
+    unsigned long baseCount;
+    unsigned long size;             // 256 or 65536
+    int highWritten;                // TMRxH written and TMRxL not yet
+    unsigned char buffer;           // TMRxH as it was before TMRxL was last touched, what a TMRxL write takes
+} hostTimerType;
+
+void isr (void) __attribute__ ((weak));     // The program's interrupt routine, if it has one
+
+// Some variables
+hostTimerType hostTimer [hostTimerCount];
+hostSfrsType hostSeen;              // The registers as they were after the last access, to see what was written
+int hostStarted, hostInIsr;
+volatile sig_atomic_t hostDepth;    // Above 0 while the model is running
+unsigned long long hostIsrNs, hostInterrupts, hostIsrTcy = 30;
+unsigned long long hostTxDoneNs;    // When the shift register is empty
+int hostTxFull;                     // TXREG holds a byte waiting for the shift register
+unsigned char hostTxByte;
+unsigned long long hostUartBytes;
+FILE *hostUart;
+sourceType hostAn [hostAdcInputs];
+int hostAnSet [hostAdcInputs];
+double hostSourceOhms = 2500, hostHoldVolts;
+unsigned long long hostAdcStartNs, hostAdcDoneNs = hostNever;   // The conversion going, hostNever when there is none
+unsigned long long hostAdcFromNs;   // When the hold capacitor started charging to the selected input
+unsigned long long hostConversions;
+double hostCcp1Hz, hostCcp1Duty = 0.5;     // The signal on RC2, 0Hz when there is none
+int hostCcp1Rising, hostCcp1Every;  // The edges CCP1CON captures
+long long hostCcp1Edge;             // Which edge of the signal the next capture is
+unsigned long long hostCcp1Next = hostNever;
+unsigned char hostEeprom [hostEepromSize];
+int hostUnlock;                     // 0x55 then 0xAA written to EECON2
+unsigned long long hostEeDoneNs = hostNever;    // When the byte being written is done
+unsigned int hostEeAddress;
+unsigned char hostEeByte;
+unsigned long long hostEeWrites;
+const char *hostEepromFile;
+unsigned long long hostIdleAt;      // PIC time at the last idle check
+int hostIdleTicks;
+
+// The subroutines
+
+unsigned long hostCount (int n, unsigned long long now)     // What timer n holds at now
+{
+    hostTimerType *timer = &hostTimer [n];
+    if (!timer -> on) return timer -> baseCount;
+    return (timer -> baseCount + (now - timer -> baseNs) / timer -> tickNs) % timer -> size;
+}
+
+void hostTimerWrite (int n, unsigned long count, unsigned long long now)   // Also clears the prescaler
+{
+    hostTimer [n].baseNs = now;
+    hostTimer [n].baseCount = count % hostTimer [n].size;
+}
+
+void hostTimerSet (int n, unsigned long long now)   // T0CON, T1CON or T3CON has changed
+{
+    hostTimerType *timer = &hostTimer [n];
+    unsigned long count = hostCount (n, now);
+    if (n == 0)
+    {
+        timer -> on = hostSfrs.T0CONbits.TMR0ON && !hostSfrs.T0CONbits.T0CS;
+        timer -> tickNs = hostTcyNs << (hostSfrs.T0CONbits.PSA ? 0 : hostSfrs.T0CONbits.T0PS + 1);
+        timer -> size = hostSfrs.T0CONbits.T08BIT ? 256 : 65536;
+    }
+    else if (n == 1)
+    {
+        timer -> on = hostSfrs.T1CONbits.TMR1ON && !hostSfrs.T1CONbits.TMR1CS;
+        timer -> tickNs = hostTcyNs << hostSfrs.T1CONbits.T1CKPS;
+        timer -> size = 65536;
+    }
+    else
+    {
+        timer -> on = hostSfrs.T3CONbits.TMR3ON && !hostSfrs.T3CONbits.TMR3CS;
+        timer -> tickNs = hostTcyNs << hostSfrs.T3CONbits.T3CKPS;
+        timer -> size = 65536;
+    }
+    timer -> baseNs = now;
+    timer -> baseCount = count % timer -> size;
+}
+
+unsigned long long hostEdgeNs (long long edge)     // When the edge, counted from the start, comes
+{
+    double period = 1e9 / hostCcp1Hz;
+    return (unsigned long long) ceil (edge * period + (hostCcp1Rising ? 0 : hostCcp1Duty * period));
+}
+
+void hostCcp1Set (unsigned long long now)   // CCP1CON has changed, the prescaler starts again
+{
+    unsigned char mode = hostSfrs.CCP1CONbits.CCP1M;
+    double period;
+    hostCcp1Next = hostNever;
+    if (hostCcp1Hz <= 0 || mode < 4 || mode > 7) return;   // Only the capture modes
+    period = 1e9 / hostCcp1Hz;
+    hostCcp1Rising = mode != 4;
+    hostCcp1Every = mode == 6 ? 4 : mode == 7 ? 16 : 1;
+    hostCcp1Edge = (long long) floor (((double) now - (hostCcp1Rising ? 0 : hostCcp1Duty * period)) / period) + hostCcp1Every;
+    hostCcp1Next = hostEdgeNs (hostCcp1Edge);
+}
+
+int hostCcp2Timer (void)            // The timer CCP2 compares with
+{
+    return hostSfrs.T3CONbits.T3CCP2 || hostSfrs.T3CONbits.T3CCP1 ? 3 : 1;
+}
+
+unsigned long long hostReaches (int n, unsigned long count)    // When timer n next gets to count, or hostNever
+{
+    hostTimerType *timer = &hostTimer [n];
+    unsigned long counts;
+    if (!timer -> on) return hostNever;
+    counts = count > timer -> baseCount ? count - timer -> baseCount : timer -> size - timer -> baseCount + count;
+    return timer -> baseNs + counts * timer -> tickNs;
+}
+
+unsigned long long hostByteNs (void)    // 10 bits at the baud rate set by SPBRG, BRGH and BRG16
+{
+    unsigned long divide, clocks;
+    divide = hostSfrs.BAUDCONbits.BRG16 ? ((unsigned long) hostSfrs.SPBRGH << 8 | hostSfrs.SPBRG) : hostSfrs.SPBRG;
+    clocks = hostSfrs.BAUDCONbits.BRG16 ? (hostSfrs.TXSTAbits.BRGH ? 4 : 16) : (hostSfrs.TXSTAbits.BRGH ? 16 : 64);
+    return 10 * clocks * (divide + 1) * hostOscNs;
+}
+
+void hostSend (unsigned char info, unsigned long long at)  // A byte goes into the shift register
+{
+    hostTxDoneNs = at + hostByteNs ();
+    hostUartBytes ++;
+    if (hostUart) fputc (info, hostUart);
+}
+
+unsigned long long hostTadNs (void)    // From ADCS, the RC clock taken as 1.5us
+{
+    static const unsigned char divide [8] = {2, 8, 32, 0, 4, 16, 64, 0};
+    unsigned char clock = hostSfrs.ADCON2bits.ADCS;
+    return divide [clock] ? divide [clock] * hostOscNs : 1500;
+}
+
+void hostAdcStart (unsigned long long at)  // GO has been set
+{
+    static const unsigned char acquisition [8] = {0, 2, 4, 6, 8, 12, 16, 20};
+    if (!hostSfrs.ADCON0bits.ADON || hostAdcDoneNs != hostNever) return;
+    hostAdcStartNs = at + acquisition [hostSfrs.ADCON2bits.ACQT] * hostTadNs ();
+    hostAdcDoneNs = hostAdcStartNs + 11 * hostTadNs ();
+}
+
+void hostAdcFinish (unsigned long long at)     // The conversion is done
+{
+    unsigned char channel = hostSfrs.ADCON0bits.CHS;
+    unsigned long long tadNs = hostTadNs ();
+    double input = 0, charging, counts;
+    int result;
+    if (channel < hostAdcInputs && hostAnSet [channel]) input = sourceVolts (&hostAn [channel], hostAdcStartNs / 1e9);
+    charging = hostAdcStartNs > hostAdcFromNs ? (hostAdcStartNs - hostAdcFromNs) * 1e-9 : 0;
+    hostHoldVolts = input + (hostHoldVolts - input) * exp (-charging / (hostHoldFarads * (hostSourceOhms + hostAdcOhms)));
+    counts = hostHoldVolts / sourceVref * 1024.0;
+    if (tadNs < 700) counts += (700.0 / tadNs - 1.0) * 4.0 * sourceNoise ();   // Too fast for the converter
+    result = sourceCounts (counts * sourceVref / 1024.0);
+    if (hostSfrs.ADCON2bits.ADFM)   // Right justified
+    {
+        hostSfrs.ADRESH = result >> 8;
+        hostSfrs.ADRESL = result & 0xFF;
+    }
+    else
+    {
+        hostSfrs.ADRESH = result >> 2;
+        hostSfrs.ADRESL = (result & 0x03) << 6;
+    }
+    hostSfrs.ADCON0bits.GO = 0;
+    hostSfrs.PIR1bits.ADIF = 1;
+    hostAdcDoneNs = hostNever;
+    hostAdcFromNs = at;             // The hold capacitor is connected to the input again
+    hostConversions ++;
+}
+
+void hostEepromSave (void)          // At the end, for the next run
+{
+    FILE *file = fopen (hostEepromFile, "wb");
+    if (!file || fwrite (hostEeprom, 1, hostEepromSize, file) != hostEepromSize) perror (hostEepromFile);
+    if (file) fclose (file);
+}
+
+void hostEepromLoad (void)
+{
+    FILE *file;
+    memset (hostEeprom, 0xFF, hostEepromSize);      // Erased
+    if (!(hostEepromFile = getenv ("PIC_EEPROM"))) return;
+    if ((file = fopen (hostEepromFile, "rb")))      // Not there yet is the same as erased
+    {
+        if (fread (hostEeprom, 1, hostEepromSize, file) != hostEepromSize) fprintf (stderr, "%s is short\n", hostEepromFile);
+        fclose (file);
+    }
+    atexit (hostEepromSave);
+}
+
+void hostEepromCommit (unsigned long long now)  // EECON1 and EECON2 as written by the program
+{
+    unsigned int address = ((unsigned int) hostSfrs.EEADRH << 8 | hostSfrs.EEADR) & (hostEepromSize - 1);
+    int data = !hostSfrs.EECON1bits.EEPGD && !hostSfrs.EECON1bits.CFGS;
+    if (hostSfrs.EECON2 != 0xFFFF)  // Written
+    {
+        hostUnlock = hostSfrs.EECON2 == 0x55 ? 1 : hostSfrs.EECON2 == 0xAA && hostUnlock == 1 ? 2 : 0;
+        hostSfrs.EECON2 = 0xFFFF;
+    }
+    if (hostSfrs.EECON1bits.RD)     // The byte is there for the next instruction
+    {
+        if (data) hostSfrs.EEDATA = hostEeprom [address];
+        hostSfrs.EECON1bits.RD = 0;
+    }
+    if (hostSfrs.EECON1bits.WR && !hostSeen.EECON1bits.WR)
+    {
+        if (hostUnlock == 2 && hostSfrs.EECON1bits.WREN && data && hostEeDoneNs == hostNever)
+        {
+            hostEeAddress = address;
+            hostEeByte = hostSfrs.EEDATA;
+            hostEeDoneNs = now + hostEepromNs;
+        }
+        else if (hostEeDoneNs == hostNever) hostSfrs.EECON1bits.WR = 0;    // Not unlocked, nothing happens
+        hostUnlock = 0;
+    }
+}
+
+// The next thing that will happen: 0 to 3 a timer going past its top, 4 a CCP2 match, 5 the
+// shift register taking the byte in TXREG, 6 the ADC finishing a conversion, 7 the EEPROM
+// finishing a byte, 8 a CCP1 capture
+
+unsigned long long hostNext (int *what)
+{
+    unsigned long long next = hostNever, at;
+    int n, ccp2;
+    for (n = 0; n < hostTimerCount; n ++)
+    {
+        if (n == 2) continue;
+        at = hostReaches (n, 0);
+        if (at < next)
+        {
+            next = at;
+            *what = n;
+        }
+    }
+    ccp2 = hostCcp2Timer ();
+    if ((hostSfrs.CCP2CONbits.CCP2M & 0x0E) == 0x0A && hostSfrs.CCPR2)    // 1010 flag only, 1011 special event
+    {
+        at = hostReaches (ccp2, hostSfrs.CCPR2);
+        if (at < next)
+        {
+            next = at;
+            *what = 4;
+        }
+    }
+    if (hostTxFull && hostTxDoneNs < next)
+    {
+        next = hostTxDoneNs;
+        *what = 5;
+    }
+    if (hostAdcDoneNs < next)
+    {
+        next = hostAdcDoneNs;
+        *what = 6;
+    }
+    if (hostEeDoneNs < next)
+    {
+        next = hostEeDoneNs;
+        *what = 7;
+    }
+    if (hostCcp1Next < next)
+    {
+        next = hostCcp1Next;
+        *what = 8;
+    }
+    return next;
+}
+
+void hostEvent (int what, unsigned long long at)    // Makes it happen
+{
+    if (what < hostTimerCount)      // Gone past the top to 0
+    {
+        hostTimerWrite (what, 0, at);
+        if (what == 0) hostSfrs.INTCONbits.TMR0IF = 1;
+        else if (what == 1) hostSfrs.PIR1bits.TMR1IF = 1;
+        else hostSfrs.PIR2bits.TMR3IF = 1;
+    }
+    else if (what == 4)             // CCPR2 matched, the special event sends the timer back to 0 and starts the ADC
+    {
+        hostSfrs.PIR2bits.CCP2IF = 1;
+        hostTimerWrite (hostCcp2Timer (), hostSfrs.CCP2CONbits.CCP2M == 0x0B ? 0 : hostSfrs.CCPR2, at);
+        if (hostSfrs.CCP2CONbits.CCP2M == 0x0B && hostSfrs.ADCON0bits.ADON && hostAdcDoneNs == hostNever)
+        {
+            hostSfrs.ADCON0bits.GO = 1;
+            hostAdcStart (at);
+        }
+    }
+    else if (what == 5)             // The shift register is empty, TXREG goes into it
+    {
+        hostTxFull = 0;
+        hostSend (hostTxByte, at);
+    }
+    else if (what == 6) hostAdcFinish (at);
+    else if (what == 7)             // The EEPROM byte is written
+    {
+        hostEeprom [hostEeAddress] = hostEeByte;
+        hostSfrs.EECON1bits.WR = 0;
+        hostSfrs.PIR2bits.EEIF = 1;
+        hostEeDoneNs = hostNever;
+        hostEeWrites ++;
+    }
+    else                            // The edge CCP1 was waiting for
+    {
+        hostSfrs.CCPR1 = hostCount (hostSfrs.T3CONbits.T3CCP2 ? 3 : 1, at);
+        hostSfrs.PIR1bits.CCP1IF = 1;
+        hostCcp1Edge += hostCcp1Every;
+        hostCcp1Next = hostEdgeNs (hostCcp1Edge);
+    }
+}
+
+int hostPending (void)              // An enabled interrupt flag is up
+{
+    if (hostSfrs.INTCON & (hostSfrs.INTCON >> 3) & 0x07) return 1;     // TMR0IF, INT0IF and RBIF with their enables
+    return hostSfrs.INTCONbits.PEIE && ((hostSfrs.PIR1 & hostSfrs.PIE1) || (hostSfrs.PIR2 & hostSfrs.PIE2));
+}
+
+void hostCommit (void);
+void hostRun (void);
+
+void hostInterrupt (void)           // The PIC's interrupt: GIE off, the isr, RETFIE turns GIE back on
+{
+    unsigned long long start = hostTimeNs ();
+    hostInIsr = 1;
+    hostSfrs.INTCONbits.GIE = 0;
+    hostDelayNs (hostIsrTcy / 2 * hostTcyNs);   // Getting there and saving the registers
+    hostRun ();
+    if (isr) isr ();
+    hostCommit ();                  // Its last write
+    hostDelayNs ((hostIsrTcy - hostIsrTcy / 2) * hostTcyNs);
+    hostSfrs.INTCONbits.GIE = 1;
+    hostInIsr = 0;
+    hostInterrupts ++;
+    hostIsrNs += hostTimeNs () - start;
+}
+
+void hostRun (void)                 // Catches up with the PIC time and runs the interrupts that are due
+{
+    unsigned long long next;
+    int what = 0, ran = 0;
+    for (;;)
+    {
+        while ((next = hostNext (&what)) <= hostTimeNs ()) hostEvent (what, next);
+        hostSfrs.PIR1bits.TXIF = !hostTxFull;
+        hostSfrs.TXSTAbits.TRMT = !hostTxFull && hostTimeNs () >= hostTxDoneNs;
+        if (ran || hostInIsr || !hostSfrs.INTCONbits.GIE || !hostPending ()) break;
+        hostInterrupt ();
+        ran = 1;                    // The program gets at least one access before the next, as the PIC runs one instruction
+    }
+    memcpy (&hostSeen, (const void *) &hostSfrs, sizeof hostSeen);     // What changed here was not written by the program
+}
+
+void hostCommit (void)              // Acts on what the program has written since the last access
+{
+    unsigned long long now = hostTimeNs ();
+    int n;
+    if (hostSfrs.T0CON != hostSeen.T0CON) hostTimerSet (0, now);
+    if (hostSfrs.T1CON != hostSeen.T1CON) hostTimerSet (1, now);
+    if (hostSfrs.T3CON != hostSeen.T3CON) hostTimerSet (3, now);
+    if (hostSfrs.TMR0H != hostSeen.TMR0H) hostTimer [0].highWritten = 1;       // Only into the buffer
+    if (hostSfrs.TMR1H != hostSeen.TMR1H)
+    {
+        if (hostSfrs.T1CONbits.RD16) hostTimer [1].highWritten = 1;
+        else hostTimerWrite (1, (unsigned long) hostSfrs.TMR1H << 8 | (hostCount (1, now) & 0xFF), now);
+    }
+    if (hostSfrs.TMR3H != hostSeen.TMR3H)
+    {
+        if (hostSfrs.T3CONbits.RD16) hostTimer [3].highWritten = 1;
+        else hostTimerWrite (3, (unsigned long) hostSfrs.TMR3H << 8 | (hostCount (3, now) & 0xFF), now);
+    }
+    for (n = 0; n < hostTimerCount; n ++)       // TMRxL written, with the buffered TMRxH
+    {
+        volatile unsigned char *low = n == 0 ? &hostSfrs.TMR0L : n == 1 ? &hostSfrs.TMR1L : &hostSfrs.TMR3L;
+        unsigned char seen = n == 0 ? hostSeen.TMR0L : n == 1 ? hostSeen.TMR1L : hostSeen.TMR3L;
+        int rd16 = n == 0 || (n == 1 ? hostSfrs.T1CONbits.RD16 : hostSfrs.T3CONbits.RD16);
+        if (n == 2 || (*low == seen && hostTimer [n].highWritten < 2)) continue;
+        if (hostTimer [n].highWritten < 2 && rd16) low [1] = hostTimer [n].buffer;    // The read of TMRxL did not happen
+        if (n == 0 && hostSfrs.T0CONbits.T08BIT) hostTimerWrite (n, *low, now);
+        else if (rd16) hostTimerWrite (n, (unsigned long) low [1] << 8 | *low, now);
+        else hostTimerWrite (n, (hostCount (n, now) & 0xFF00) | *low, now);
+        hostTimer [n].highWritten = 0;
+    }
+    if (hostSfrs.ADCON0bits.CHS != hostSeen.ADCON0bits.CHS && hostAdcDoneNs == hostNever) hostAdcFromNs = now;
+    if (hostSfrs.ADCON0bits.GO && !hostSeen.ADCON0bits.GO) hostAdcStart (now);
+    else if (!hostSfrs.ADCON0bits.GO && hostSeen.ADCON0bits.GO) hostAdcDoneNs = hostNever;     // Cleared, the conversion stops
+    if (hostSfrs.CCP1CON != hostSeen.CCP1CON) hostCcp1Set (now);
+    hostEepromCommit (now);
+    if (hostSfrs.TXREG != 0xFFFF)   // A byte written to TXREG
+    {
+        if (hostTxFull || now < hostTxDoneNs)
+        {
+            hostTxFull = 1;         // Waits for the shift register, a second one is lost as on the PIC
+            hostTxByte = hostSfrs.TXREG;
+        }
+        else if (hostSfrs.TXSTAbits.TXEN && hostSfrs.RCSTAbits.SPEN) hostSend (hostSfrs.TXREG, now);
+        hostSfrs.TXREG = 0xFFFF;
+    }
+    memcpy (&hostSeen, (const void *) &hostSfrs, sizeof hostSeen);
+}
+
+void hostIdle (int signal)          // The processor time signal, see the top of this file
+{
+    unsigned long long now = hostTimeNs (), limit, firstIsr = 0, next, interrupts = hostInterrupts;
+    int what = 0;
+    (void) signal;
+    if (hostDepth || now != hostIdleAt || ++ hostIdleTicks < (hostSfrs.INTCONbits.GIE ? 2 : 1000))
+    {
+        if (now != hostIdleAt) hostIdleTicks = 0;
+        hostIdleAt = now;
+        return;
+    }
+    hostDepth ++;
+    if (!hostSfrs.INTCONbits.GIE)   // Nothing can ever happen, so the time is up
+    {
+        hostDelayNs (hostNever / 2);
+        exit (0);
+    }
+    limit = now + hostIdleNs;
+    while (now < limit && (!firstIsr || now < firstIsr + hostIdleNs / 100))     // 1ms after the first interrupt
+    {
+        next = hostNext (&what);
+        if (next > limit) next = limit;
+        if (next > now) hostDelayNs (next - now);
+        hostRun ();
+        now = hostTimeNs ();
+        if (!firstIsr && hostInterrupts != interrupts) firstIsr = now;
+    }
+    hostIdleAt = hostTimeNs ();
+    hostIdleTicks = 0;
+    hostDepth --;
+}
+
+void hostStats (void)
+{
+    unsigned long long now = hostTimeNs ();
+    fprintf (stderr, "picSeconds=%.6f interrupts=%llu isrSeconds=%.6f isrLoad=%.4f uartBytes=%llu conversions=%llu eepromWrites=%llu\n",
+             now / 1e9, hostInterrupts, hostIsrNs / 1e9, now ? (double) hostIsrNs / now : 0.0, hostUartBytes, hostConversions,
+             hostEeWrites);
+}
+
+void hostStart (void)               // Reset, the first time anything is touched
+{
+    struct itimerval every = { { 0, 1000 }, { 0, 1000 } };
+    char name [8], *copy;
+    const char *text;
+    int n;
+    hostStarted = 1;
+    for (n = 0; n < hostAdcInputs; n ++)
+    {
+        snprintf (name, sizeof name, "PIC_AN%d", n);
+        if (!(text = getenv (name))) continue;
+        copy = strdup (text);
+        if (!(hostAnSet [n] = sourceParse (&hostAn [n], copy))) fprintf (stderr, "cannot use signal %s=%s\n", name, text);
+        free (copy);
+    }
+    if ((text = getenv ("PIC_ADC_OHMS"))) hostSourceOhms = atof (text);
+    if ((text = getenv ("PIC_CCP1")))
+    {
+        hostCcp1Hz = atof (text);
+        if ((text = strchr (text, ':'))) hostCcp1Duty = atof (text + 1) / 100.0;
+    }
+    hostEepromLoad ();
+    if ((text = getenv ("PIC_ISR_TCY"))) hostIsrTcy = atoi (text);
+    if ((text = getenv ("PIC_UART")) && !(hostUart = fopen (text, "wb"))) perror (text);
+    if (getenv ("PIC_STATS")) atexit (hostStats);
+    hostTimerSet (0, 0);            // Timer 0 runs from reset, T0CON = 0xFF
+    hostTimerSet (1, 0);
+    hostTimerSet (3, 0);
+    memcpy (&hostSeen, (const void *) &hostSfrs, sizeof hostSeen);
+    signal (SIGVTALRM, hostIdle);
+    setitimer (ITIMER_VIRTUAL, &every, NULL);
+}
+
+void hostRefresh (volatile void *sfr)   // A timer that is about to be read holds its count
+{
+    unsigned long long now = hostTimeNs ();
+    int n;
+    for (n = 0; n < hostTimerCount; n ++)
+    {
+        volatile unsigned char *low = n == 0 ? &hostSfrs.TMR0L : n == 1 ? &hostSfrs.TMR1L : &hostSfrs.TMR3L;
+        unsigned long count;
+        if (n == 2) continue;
+        count = hostCount (n, now);
+        if (sfr == low)
+        {
+            if (hostTimer [n].highWritten)      // TMRxH then TMRxL, a write
+            {
+                hostTimer [n].highWritten = 2;
+                return;
+            }
+            hostTimer [n].buffer = low [1];     // In case this is a write after TMRxH was written with what it held
+            low [0] = count & 0xFF;
+            if (n || !hostSfrs.T0CONbits.T08BIT) low [1] = count >> 8;   // The top byte is copied as it is read
+        }
+        else if (sfr == low + 1 && n && !(n == 1 ? hostSfrs.T1CONbits.RD16 : hostSfrs.T3CONbits.RD16) && !hostTimer [n].highWritten)
+            low [1] = count >> 8;   // Without RD16 TMRxH is read as it is
+    }
+}
+
+volatile void *hostTouch (volatile void *sfr)  // Every access to a register in hostSfrs comes through here
+{
+    hostDepth ++;
+    if (!hostStarted) hostStart ();
+    hostCommit ();
+    hostDelayNs (hostTcyNs);        // One instruction
+    hostRun ();
+    hostRefresh (sfr);
+    memcpy (&hostSeen, (const void *) &hostSfrs, sizeof hostSeen);
+    hostDepth --;
+    return sfr;
+}
+
+void hostTick (void)                // The pins and delays in pinsVcd.c call this after moving the time on
+{
+    if (!hostStarted) return;
+    hostDepth ++;
+    hostCommit ();
+    hostRun ();
+    hostDepth --;
+}
+
+void hostWait (unsigned long long ns)   // __delay_us and __delay_ms, the interrupts run on time and make it longer
+{
+    unsigned long long end, next, isrNs = hostIsrNs;
+    int what = 0;
+    if (!hostStarted) hostStart ();
+    hostDepth ++;
+    end = hostTimeNs () + ns;
+    while (hostTimeNs () < end + (hostIsrNs - isrNs))
+    {
+        hostCommit ();
+        next = hostNext (&what);
+        if (next > end + (hostIsrNs - isrNs)) next = end + (hostIsrNs - isrNs);
+        if (next > hostTimeNs ()) hostDelayNs (next - hostTimeNs ());
+        hostRun ();
+    }
+    hostDepth --;
+}
+
+#undef __delay_us
+#undef __delay_ms
+#define __delay_us(x)   hostWait ((x) * 1000ULL)
+#define __delay_ms(x)   hostWait ((x) * 1000000ULL)
+
+#endif
@@ -0,0 +1,230 @@
+/*
+ * File:   pinsVcd.c
+ * Name: hostPinWrite and hostPinRead that write a VCD file, see pinsVcd.h
+ *
+ * Every change is put in a 1MB buffer as text and the buffer is written to the file
+ * when it is full, so a pin change costs a few string copies and not a call to the C
+ * library. A traffic light run of 20 seconds of PIC time takes a few milliseconds. The
+ * buffer is also written out when the run is stopped by SIGINT or SIGTERM.
+ *
+ * Created on October 19, 2026
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pinsVcd.h"
+
+#define ports       5               // PORTA to PORTE
+#define bufferSize  (1 << 20)
+#define maxInputs   64              // Entries in PINS_VCD_INPUTS
+
+typedef struct
+{
+    unsigned long long ns;          // When the pin goes to level
+    int port, bit, level;
+} inputType;
+
+static char buffer [bufferSize];
+static size_t used;
+static FILE *vcd;
+static unsigned char latch [ports];
+static unsigned long long timeNs, lastTimeNs, stopNs;
+static char pinNames [ports * 8][32];
+static inputType inputs [maxInputs];
+static int inputCount, nextInput;
+static unsigned char inputMask [ports], inputLevel [ports];  // Pins driven from outside and their levels
+
+static void flush (void)
+{
+    fwrite (buffer, 1, used, vcd);
+    used = 0;
+}
+
+static void put (const char *text, size_t length)
+{
+    if (used + length > bufferSize) flush ();
+    memcpy (buffer + used, text, length);
+    used += length;
+}
+
+static void putTime (unsigned long long ns)    // "#<ns>\n" without printf
+{
+    char text [24];
+    int n = sizeof text;
+    text [-- n] = '\n';
+    do
+    {
+        text [-- n] = '0' + ns % 10;
+        ns /= 10;
+    }
+    while (ns);
+    text [-- n] = '#';
+    put (text + n, sizeof text - n);
+}
+
+static void finish (void)
+{
+    if (!vcd) return;
+    putTime (timeNs);
+    flush ();
+    fclose (vcd);
+    vcd = NULL;
+}
+
+static void stopped (int signal)    // Ctrl-C or kill, exit so finish () still writes the file
+{
+    exit (128 + signal);
+}
+
+static void putChange (int index, int bit, int level)
+{
+    char change [3] = { 0, 0, '\n' };
+    change [0] = level ? '1' : '0';
+    change [1] = '!' + index * 8 + bit;
+    put (change, sizeof change);
+}
+
+static void readInputs (const char *text)   // "A4=1@2.5,A4=0@2.6", kept in time order
+{
+    inputType input;
+    int n;
+    while (text && *text && inputCount < maxInputs)
+    {
+        const char *end = strchr (text, ','), *at = strchr (text, '@');
+        if (!end) end = text + strlen (text);
+        input.port = text [0] - 'A';
+        input.bit = text [1] - '0';
+        input.level = text [3] == '1';
+        input.ns = at && at < end ? atof (at + 1) * 1e9 : 0;
+        if (input.port >= 0 && input.port < ports && input.bit >= 0 && input.bit < 8 && text [2] == '=')
+        {
+            for (n = inputCount; n > 0 && inputs [n - 1].ns > input.ns; n --) inputs [n] = inputs [n - 1];
+            inputs [n] = input;
+            inputCount ++;
+            inputMask [input.port] |= 1 << input.bit;
+        }
+        text = *end ? end + 1 : end;
+    }
+}
+
+static void moveInputs (void)       // Puts the input changes up to now into the file
+{
+    inputType *input;
+    unsigned char was;
+    while (nextInput < inputCount && inputs [nextInput].ns <= timeNs)
+    {
+        input = &inputs [nextInput ++];
+        was = inputLevel [input -> port];
+        inputLevel [input -> port] = (was & ~(1 << input -> bit)) | (input -> level << input -> bit);
+        if (was == inputLevel [input -> port]) continue;
+        if (input -> ns != lastTimeNs)
+        {
+            putTime (input -> ns);
+            lastTimeNs = input -> ns;
+        }
+        putChange (input -> port, input -> bit, input -> level);
+    }
+}
+
+static void moveOn (unsigned long long ns)  // The PIC time goes on, it stops the program when it is up
+{
+    timeNs += ns;
+    if (timeNs >= stopNs)
+    {
+        timeNs = stopNs;
+        moveInputs ();
+        exit (0);                   // finish () writes the end of the file
+    }
+    moveInputs ();
+}
+
+static void start (void)            // Names the pins and writes the VCD header
+{
+    const char *fileName = getenv ("PINS_VCD"), *seconds = getenv ("PINS_VCD_SECONDS");
+    const char *names = getenv ("PINS_VCD_NAMES");
+    int pin;
+
+    for (pin = 0; pin < ports * 8; pin ++) sprintf (pinNames [pin], "R%c%d", 'A' + pin / 8, pin % 8);
+    while (names && *names)         // "B5=E,B4=RS"
+    {
+        int port = names [0] - 'A', bit = names [1] - '0';
+        const char *end = strchr (names, ',');
+        size_t length;
+        if (!end) end = names + strlen (names);
+        if (port >= 0 && port < ports && bit >= 0 && bit < 8 && names [2] == '=')
+        {
+            length = end - names - 3;
+            if (length > sizeof pinNames [0] - 1) length = sizeof pinNames [0] - 1;
+            memcpy (pinNames [port * 8 + bit], names + 3, length);
+            pinNames [port * 8 + bit][length] = 0;
+        }
+        names = *end ? end + 1 : end;
+    }
+    stopNs = (seconds ? atof (seconds) : 30.0) * 1e9;
+    readInputs (getenv ("PINS_VCD_INPUTS"));
+    vcd = fopen (fileName ? fileName : "pins.vcd", "w");
+    if (!vcd)
+    {
+        perror (fileName ? fileName : "pins.vcd");
+        exit (1);
+    }
+    fprintf (vcd, "$timescale 1ns $end\n$scope module pic $end\n");
+    for (pin = 0; pin < ports * 8; pin ++) fprintf (vcd, "$var wire 1 %c %s $end\n", '!' + pin, pinNames [pin]);
+    fprintf (vcd, "$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n");
+    for (pin = 0; pin < ports * 8; pin ++) fprintf (vcd, "0%c\n", '!' + pin);
+    fprintf (vcd, "$end\n");
+    atexit (finish);
+    signal (SIGINT, stopped);
+    signal (SIGTERM, stopped);
+    moveInputs ();                  // The ones from the start
+}
+
+void hostPinWrite (char port, unsigned char mask, unsigned char value)
+{
+    unsigned char changed, bit;
+    int index = port - 'A';
+
+    if (!vcd) start ();
+    if (index < 0 || index >= ports) return;
+    moveOn (hostTcyNs);             // A write to LATx is one instruction
+    value = (latch [index] & ~mask) | (value & mask);
+    changed = (latch [index] ^ value) & ~inputMask [index];    // A pin driven from outside keeps its input level
+    latch [index] = value;
+    if (changed)
+    {
+        if (timeNs != lastTimeNs)
+        {
+            putTime (timeNs);
+            lastTimeNs = timeNs;
+        }
+        for (bit = 0; bit < 8; bit ++)
+            if (changed & (1 << bit)) putChange (index, bit, (value >> bit) & 1);
+    }
+    if (hostTick) hostTick ();      // Last, an interrupt it runs may write the pins again
+}
+
+unsigned char hostPinRead (char port)   // The latch, with the PINS_VCD_INPUTS pins at their input level
+{
+    int index = port - 'A';
+    unsigned char value;
+    if (!vcd) start ();
+    moveOn (hostTcyNs);
+    if (hostTick) hostTick ();
+    if (index < 0 || index >= ports) return 0;
+    value = (latch [index] & ~inputMask [index]) | (inputLevel [index] & inputMask [index]);
+    return value;
+}
+
+void hostDelayNs (unsigned long long ns)
+{
+    if (!vcd) start ();
+    moveOn (ns);
+    if (hostTick) hostTick ();
+}
+
+unsigned long long hostTimeNs (void)
+{
+    return timeNs;
+}
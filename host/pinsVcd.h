@@ -0,0 +1,53 @@
+/*
+ * File:   pinsVcd.h
+ * Name: Recording the pins of a program run on the PC as a VCD file
+ *
+ * This runs on a Linux PC, not on the PIC. A program built with PIN_HOST_BACKEND defined
+ * (see pins_HHWardBook1.h) calls hostPinWrite and hostPinRead instead of writing LATx and
+ * reading PORTx. pinsVcd.c supplies them and writes every pin that changes, with its time,
+ * into a Value Change Dump file that GTKWave can show.
+ *
+ * The time is not the PC's time. It is a count of the PIC's time: every pin write takes
+ * one instruction cycle (0.5us at 8MHz) and __delay_us / __delay_ms move it on by the
+ * delay, so a 5 second traffic light phase is written in a few microseconds of PC time.
+ * host/xc.h, the PC's stand in for XC8's xc.h, includes this file and host/picModel.h,
+ * which moves the timers on with this time and runs the interrupts (hostTick).
+ *
+ * Build, e.g. for the traffic lights, from the top folder:
+ *      gcc -O2 -DPIN_HOST_BACKEND -Ihost -o traffic trafficLightMain.c host/pinsVcd.c -lm
+ *      PINS_VCD_NAMES="B0=red,B1=amber,B2=green" PINS_VCD_SECONDS=20 ./traffic
+ *
+ * Settings, all optional:
+ *      PINS_VCD            file to write, pins.vcd if not set
+ *      PINS_VCD_SECONDS    PIC time to run for before stopping, 30 seconds if not set
+ *      PINS_VCD_NAMES      names for the pins, e.g. "B0=D4,B1=D5,B2=D6,B3=D7,B4=RS,B5=E"
+ *      PINS_VCD_INPUTS     levels for input pins from a PIC time in seconds on, e.g.
+ *                          "A4=1@2.5,A4=0@2.6" presses the button on RA4 for 100ms.
+ *                          Without a time it is from the start. Other pins read back
+ *                          what was last written to them.
+ *
+ * A run stops when the PIC time gets to PINS_VCD_SECONDS, or earlier when host/picModel.h
+ * sees the program waiting for something that can never happen (a while (1); with the
+ * interrupts off). Ctrl-C (SIGINT) or kill (SIGTERM) stop it at once. In every case the
+ * rest of the buffer is written out so the VCD file is complete up to that time.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef PINSVCD_H
+#define PINSVCD_H
+
+#define hostTcyNs   500ULL          // One instruction cycle at 8MHz in ns
+
+void hostPinWrite (char port, unsigned char mask, unsigned char value);
+unsigned char hostPinRead (char port);
+void hostDelayNs (unsigned long long ns);      // Moves the PIC time on, stops the program when time is up
+unsigned long long hostTimeNs (void);          // PIC time since the start
+void hostTick (void) __attribute__ ((weak));   // Called after the time moves on, supplied by host/picModel.h
+
+#undef __delay_us
+#undef __delay_ms
+#define __delay_us(x)   hostDelayNs ((x) * 1000ULL)
+#define __delay_ms(x)   hostDelayNs ((x) * 1000000ULL)
+
+#endif
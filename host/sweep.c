@@ -0,0 +1,360 @@
+/*
+ * File:   sweep.c
+ * Name: Running a program with every combination of a set of settings
+ *
+ * This runs on a Linux PC, not on the PIC. Build it from the top folder with
+ *      gcc -O2 -pthread -o sweep host/sweep.c
+ *
+ * Give it a command with {name} where each setting goes, and a list of values for each
+ * name. The command is run once for every combination, on all the PC's cores at once, and
+ * every key=value in what each run prints is put into one table:
+ *
+ *      ./sweep -c "gcc -O2 -pthread -DredTime={red} -DgreenTime={green} -o /tmp/corridor{red}_{green} \
+ *              host/corridor.c -lm && /tmp/corridor{red}_{green} -p wave" red=3000:7000:1000 green=4000,6000 > results.csv
+ *      ./sweep -json -c "gcc -O2 -DPIN_HOST_BACKEND -DlcdQuickUs={quick} -Ihost -o /tmp/lcdCheck{quick} \
+ *              host/lcdCheck.c host/lcdModel.c -lm && /tmp/lcdCheck{quick}" quick=20:60:10 > results.json
+ *
+ * Each run builds its own copy of the program with the settings as -D options, named after
+ * the values so runs going at the same time do not write over each other's.
+ *
+ * The settings the programs let you change this way are lcdNibbleMs and lcdQuickUs
+ * (lcd4Bit_HHWardBook1.h), lcdShortTicks and lcdLongTicks (lcdMulti_HHWardBook1.h),
+ * adcSetting (ADCON2 in VoltMeter_main.c) and redTime, redAmberTime, greenTime and
+ * amberTime and trafficOffset (trafficPlan_HHWardBook1.h). A run can be any command that
+ * prints key=value, a PC build as above or a script that builds with XC8 and runs the
+ * MPLAB X simulator.
+ *
+ * Options:
+ *      -j threads  how many runs at once, the number of cores if not given
+ *      -json       JSON instead of CSV
+ *      -c command  the command, run with sh -c
+ *
+ * Values are a list, a,b,c, or a range, from:to:step. Every thread takes the next run
+ * from one shared counter when it finishes the last, so a slow run does not hold up the
+ * others and the time goes down nearly in step with the number of cores. The table is in
+ * the same order as the runs whatever order they finish in. A run that fails has its exit
+ * status in the status column, or -1 if it was killed by a signal or could not be started.
+ * The values of a range are printed with as many decimals as its from or step was typed
+ * with, so 100:1000:100 gives 100, 200 ... and 0.5:2:0.25 gives 0.50, 0.75 ... CSV fields
+ * with a comma, quote or new line in them are quoted and JSON strings are escaped.
+ *
+ * The status column is the sweep's own, so a setting cannot be called status. A key a run
+ * prints with the same name as the status column or a setting is put in the table as
+ * out.name, e.g. out.status, so every column name is different.
+ *
+ * Created on October 19, 2026
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define maxSettings 16
+#define maxValues   256
+
+typedef struct
+{
+    char *name;
+    char *values [maxValues];
+    int count;
+} settingType;
+
+typedef struct
+{
+    int index [maxSettings];        // Which value of each setting
+    char **keys, **values;          // What the run printed
+    int results, status;
+} runType;
+
+static settingType settings [maxSettings];
+static int settingCount;
+static runType *runs;
+static long runCount;
+static atomic_long nextRun;
+static const char *command;
+
+static void addResult (runType *run, const char *key, const char *value)
+{
+    int n;
+    for (n = 0; n < run -> results; n ++)   // The last value of a key is kept
+        if (!strcmp (run -> keys [n], key))
+        {
+            free (run -> values [n]);
+            run -> values [n] = strdup (value);
+            return;
+        }
+    run -> keys = realloc (run -> keys, (run -> results + 1) * sizeof (char *));
+    run -> values = realloc (run -> values, (run -> results + 1) * sizeof (char *));
+    run -> keys [run -> results] = strdup (key);
+    run -> values [run -> results ++] = strdup (value);
+}
+
+static int reservedName (const char *key)  // The status column or a setting
+{
+    int n;
+    if (!strcmp (key, "status")) return 1;
+    for (n = 0; n < settingCount; n ++) if (settings [n].name && !strcmp (key, settings [n].name)) return 1;
+    return 0;
+}
+
+static char *buildCommand (const runType *run)  // The command with {name} replaced by the values of this run
+{
+    size_t size = strlen (command) + 1, used = 0;
+    char *text = malloc (size);
+    const char *from = command;
+    int n;
+
+    while (*from)
+    {
+        const char *value = NULL;
+        size_t skip = 1;
+        if (*from == '{')
+            for (n = 0; n < settingCount; n ++)
+            {
+                size_t length = strlen (settings [n].name);
+                if (!strncmp (from + 1, settings [n].name, length) && from [length + 1] == '}')
+                {
+                    value = settings [n].values [run -> index [n]];
+                    skip = length + 2;
+                    break;
+                }
+            }
+        if (!value)
+        {
+            value = from;
+            skip = 1;
+        }
+        size_t length = value == from ? 1 : strlen (value);
+        if (used + length + 1 > size)
+        {
+            size = (used + length + 1) * 2;
+            text = realloc (text, size);
+        }
+        memcpy (text + used, value, length);
+        used += length;
+        from += skip;
+    }
+    text [used] = 0;
+    return text;
+}
+
+static void *worker (void *unused)
+{
+    char line [4096];
+    long number;
+    (void) unused;
+
+    while ((number = atomic_fetch_add (&nextRun, 1)) < runCount)
+    {
+        runType *run = &runs [number];
+        char *text = buildCommand (run), *word, *save;
+        FILE *out = popen (text, "r");
+        free (text);
+        if (!out)
+        {
+            run -> status = -1;
+            continue;
+        }
+        while (fgets (line, sizeof line, out))
+            for (word = strtok_r (line, " \t\r\n,", &save); word; word = strtok_r (NULL, " \t\r\n,", &save))
+            {
+                char *equals = strchr (word, '=');
+                if (!equals || equals == word) continue;
+                *equals = 0;
+                if (reservedName (word))
+                {
+                    char renamed [sizeof line + 4];
+                    snprintf (renamed, sizeof renamed, "out.%s", word);
+                    addResult (run, renamed, equals + 1);
+                }
+                else addResult (run, word, equals + 1);
+            }
+        run -> status = pclose (out);
+        run -> status = run -> status != -1 && WIFEXITED (run -> status) ? WEXITSTATUS (run -> status) : -1;
+    }
+    return NULL;
+}
+
+static int decimals (const char *text)     // Digits after the point in a number as it was typed
+{
+    const char *point = strchr (text, '.');
+    return point ? (int) strspn (point + 1, "0123456789") : 0;
+}
+
+static int parseSetting (settingType *setting, char *text)
+{
+    char *equals = strchr (text, '='), *value, *save, *colon;
+    double from, to, step, x;
+    char number [64];
+    int places, n;
+
+    if (!equals) return 0;
+    *equals = 0;
+    if (reservedName (text)) return 0;  // status, or a setting given twice
+    setting -> name = text;
+    if (sscanf (equals + 1, "%lf:%lf:%lf", &from, &to, &step) == 3 && step > 0)
+    {
+        colon = strrchr (equals + 1, ':');      // Print the values with as many decimals as the from or the step had
+        places = decimals (equals + 1);
+        if (decimals (colon + 1) > places) places = decimals (colon + 1);
+        for (n = 0; (x = from + n * step) <= to + step / 1e6 && setting -> count < maxValues; n ++)
+        {
+            snprintf (number, sizeof number, "%.*f", places, x);
+            setting -> values [setting -> count ++] = strdup (number);
+        }
+        return setting -> count > 0;
+    }
+    for (value = strtok_r (equals + 1, ",", &save); value && setting -> count < maxValues; value = strtok_r (NULL, ",", &save))
+        setting -> values [setting -> count ++] = value;
+    return setting -> count > 0;
+}
+
+static int keyIndex (char ***keys, int *count, const char *key)   // Adds key to the list of columns if it is new
+{
+    int n;
+    for (n = 0; n < *count; n ++) if (!strcmp ((*keys) [n], key)) return n;
+    *keys = realloc (*keys, (*count + 1) * sizeof (char *));
+    (*keys) [*count] = (char *) key;
+    return (*count) ++;
+}
+
+static void printCsv (const char *text)    // In quotes, with any quotes doubled, if it has a comma, a quote or a new line in it
+{
+    if (!strpbrk (text, ",\"\r\n"))
+    {
+        fputs (text, stdout);
+        return;
+    }
+    putchar ('"');
+    for (; *text; text ++)
+    {
+        if (*text == '"') putchar ('"');
+        putchar (*text);
+    }
+    putchar ('"');
+}
+
+static void printJson (const char *text)   // A JSON string, with quotes, backslashes and control characters escaped
+{
+    putchar ('"');
+    for (; *text; text ++)
+    {
+        if (*text == '"' || *text == '\\') printf ("\\%c", *text);
+        else if ((unsigned char) *text < 0x20) printf ("\\u%04x", *text);
+        else putchar (*text);
+    }
+    putchar ('"');
+}
+
+static const char *resultOf (const runType *run, const char *key)
+{
+    int n;
+    for (n = 0; n < run -> results; n ++) if (!strcmp (run -> keys [n], key)) return run -> values [n];
+    return "";
+}
+
+int main (int argc, char **argv)
+{
+    int threads = sysconf (_SC_NPROCESSORS_ONLN), json = 0, arg = 1, n, columns = 0;
+    pthread_t *ids;
+    char **keys = NULL;
+    long number;
+
+    for (; arg < argc && argv [arg][0] == '-'; arg ++)
+    {
+        if (!strcmp (argv [arg], "-json")) json = 1;
+        else if (arg + 1 < argc && !strcmp (argv [arg], "-j")) threads = atoi (argv [++ arg]);
+        else if (arg + 1 < argc && !strcmp (argv [arg], "-c")) command = argv [++ arg];
+        else break;
+    }
+    for (; arg < argc && settingCount < maxSettings; arg ++)
+        if (!parseSetting (&settings [settingCount ++], argv [arg]))
+        {
+            fprintf (stderr, "cannot use setting %s\n", argv [arg]);
+            return 2;
+        }
+    if (!command || threads < 1)
+    {
+        fprintf (stderr, "usage: %s [-j threads] [-json] -c command name=a,b,c name=from:to:step ...\n", argv [0]);
+        return 2;
+    }
+
+    runCount = 1;
+    for (n = 0; n < settingCount; n ++) runCount *= settings [n].count;
+    runs = calloc (runCount, sizeof (runType));
+    for (number = 0; number < runCount; number ++)     // Run number to one value of each setting, the last setting changes fastest
+    {
+        long rest = number;
+        for (n = settingCount - 1; n >= 0; n --)
+        {
+            runs [number].index [n] = rest % settings [n].count;
+            rest /= settings [n].count;
+        }
+    }
+    if (threads > runCount) threads = runCount;
+    ids = malloc (threads * sizeof (pthread_t));
+    for (n = 0; n < threads; n ++) pthread_create (&ids [n], NULL, worker, NULL);
+    for (n = 0; n < threads; n ++) pthread_join (ids [n], NULL);
+
+    for (number = 0; number < runCount; number ++)
+        for (n = 0; n < runs [number].results; n ++) keyIndex (&keys, &columns, runs [number].keys [n]);
+    if (!json)
+    {
+        for (n = 0; n < settingCount; n ++)
+        {
+            printCsv (settings [n].name);
+            putchar (',');
+        }
+        printf ("status");
+        for (n = 0; n < columns; n ++)
+        {
+            putchar (',');
+            printCsv (keys [n]);
+        }
+        printf ("\n");
+    }
+    else printf ("[\n");
+    for (number = 0; number < runCount; number ++)
+    {
+        const runType *run = &runs [number];
+        if (!json)
+        {
+            for (n = 0; n < settingCount; n ++)
+            {
+                printCsv (settings [n].values [run -> index [n]]);
+                putchar (',');
+            }
+            printf ("%d", run -> status);
+            for (n = 0; n < columns; n ++)
+            {
+                putchar (',');
+                printCsv (resultOf (run, keys [n]));
+            }
+            printf ("\n");
+            continue;
+        }
+        printf ("  {");
+        for (n = 0; n < settingCount; n ++)
+        {
+            printJson (settings [n].name);
+            printf (": ");
+            printJson (settings [n].values [run -> index [n]]);
+            printf (", ");
+        }
+        printf ("\"status\": %d", run -> status);
+        for (n = 0; n < run -> results; n ++)
+        {
+            printf (", ");
+            printJson (run -> keys [n]);
+            printf (": ");
+            printJson (run -> values [n]);
+        }
+        printf ("}%s\n", number + 1 < runCount ? "," : "");
+    }
+    if (json) printf ("]\n");
+    return 0;
+}
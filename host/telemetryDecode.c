@@ -0,0 +1,192 @@
+/*
+ * File:   telemetryDecode.c
+ * Name: PC decoder for the frames sent by telemetry_HHWardBook1.h
+ *
+ * This runs on a Linux PC, not on the PIC. Build it with
+ *      gcc -O2 -o telemetryDecode telemetryDecode.c
+ *
+ * and run it with a serial port, a pty or a file that holds a capture of the stream
+ *      ./telemetryDecode /dev/ttyUSB0 500000
+ *      ./telemetryDecode capture.bin
+ *      ./telemetryDecode -v capture.bin        (also prints every sample)
+ *
+ * It finds the 0xA5 start bytes, checks the CRC of each frame, unpacks the 10-bit
+ * samples and uses the sequence numbers to count frames that went missing. Once a
+ * second (and at the end) it prints the totals and the sample rate over the last second.
+ *
+ * Created on October 19, 2026
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#define frameStart  0xA5
+#define maxFrame    (4 + 255 + 255 / 4 + 1)     // Largest possible frame
+
+static unsigned char crcTable [256];
+static int verbose;
+
+static unsigned long long frames, samples, dropped, crcErrors, bytesIn;
+static int lastSequence = -1;
+
+static void makeCrcTable (void)        // Same CRC-8 (polynomial 0x07) as the PIC
+{
+    int i, n;
+    for (i = 0; i < 256; i ++)
+    {
+        unsigned char crc = i;
+        for (n = 0; n < 8; n ++) crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+        crcTable [i] = crc;
+    }
+}
+
+static double now (void)
+{
+    struct timespec t;
+    clock_gettime (CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+static speed_t baudConstant (long baud)
+{
+    switch (baud)
+    {
+        case 9600: return B9600;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+        case 460800: return B460800;
+        case 500000: return B500000;
+        case 921600: return B921600;
+        case 1000000: return B1000000;
+        default: return 0;
+    }
+}
+
+static void frameDone (const unsigned char *frame)     // frame [0] is the sequence number, the start byte is not kept
+{
+    unsigned char sequence = frame [0], channel = frame [1], count = frame [2];
+    const unsigned char *data = frame + 3;
+    int group, n;
+
+    if (lastSequence >= 0) dropped += (unsigned char) (sequence - lastSequence - 1);
+    lastSequence = sequence;
+    frames ++;
+    samples += count;
+    if (!verbose) return;
+    printf ("frame %3u channel %u:", sequence, channel);
+    for (group = 0; group < count / 4; group ++, data += 5)
+        for (n = 0; n < 4; n ++)
+            printf (" %4u", (data [n] << 2) | ((data [4] >> (6 - 2 * n)) & 0x03));
+    printf ("\n");
+}
+
+static void report (const char *when, double seconds, unsigned long long samplesThen)
+{
+    fprintf (stderr, "%s: %llu frames, %llu samples, %llu dropped, %llu CRC errors, %llu bytes",
+             when, frames, samples, dropped, crcErrors, bytesIn);
+    if (seconds > 0) fprintf (stderr, ", %.0f samples/s", (samples - samplesThen) / seconds);
+    fprintf (stderr, "\n");
+}
+
+int main (int argc, char **argv)
+{
+    unsigned char buffer [4096], frame [maxFrame];
+    int fd, length = 0, need = 0, arg = 1;
+    unsigned char crc = 0;
+    double started, lastReport;
+    unsigned long long samplesAtReport = 0;
+    ssize_t got;
+
+    if (arg < argc && strcmp (argv [arg], "-v") == 0)
+    {
+        verbose = 1;
+        arg ++;
+    }
+    if (arg >= argc)
+    {
+        fprintf (stderr, "usage: %s [-v] <serial port, pty or file> [baud]\n", argv [0]);
+        return 2;
+    }
+    fd = open (argv [arg], O_RDONLY | O_NOCTTY);
+    if (fd < 0)
+    {
+        fprintf (stderr, "%s: %s\n", argv [arg], strerror (errno));
+        return 1;
+    }
+    if (isatty (fd))                    // A serial port or pty has to be put in raw mode
+    {
+        struct termios settings;
+        tcgetattr (fd, &settings);
+        cfmakeraw (&settings);
+        if (arg + 1 < argc)
+        {
+            speed_t speed = baudConstant (atol (argv [arg + 1]));
+            if (!speed)
+            {
+                fprintf (stderr, "unsupported baud rate %s\n", argv [arg + 1]);
+                return 2;
+            }
+            cfsetispeed (&settings, speed);
+            cfsetospeed (&settings, speed);
+        }
+        tcsetattr (fd, TCSANOW, &settings);
+    }
+    makeCrcTable ();
+    started = lastReport = now ();
+
+    while ((got = read (fd, buffer, sizeof buffer)) > 0)
+    {
+        ssize_t i;
+        bytesIn += got;
+        for (i = 0; i < got; i ++)
+        {
+            unsigned char info = buffer [i];
+            if (need == 0)              // Looking for the start of a frame
+            {
+                if (info == frameStart)
+                {
+                    length = 0;
+                    need = 3;           // Sequence, channel and count come next
+                    crc = 0;
+                }
+                continue;
+            }
+            frame [length ++] = info;
+            if (length == 3)
+            {
+                if (frame [2] % 4)      // Not a real frame, start looking again
+                {
+                    need = 0;
+                    continue;
+                }
+                need = 3 + frame [2] + frame [2] / 4 + 1;
+            }
+            if (length < need)
+            {
+                crc = crcTable [crc ^ info];
+                continue;
+            }
+            if (crc == info) frameDone (frame);     // The last byte is the CRC
+            else crcErrors ++;
+            need = 0;
+        }
+        if (now () - lastReport >= 1.0)
+        {
+            report ("last second", now () - lastReport, samplesAtReport);
+            lastReport = now ();
+            samplesAtReport = samples;
+        }
+    }
+    report ("total", now () - started, 0);
+    close (fd);
+    return 0;
+}
@@ -0,0 +1,168 @@
+/*
+ * File:   traceTimeline.c
+ * Name: PC viewer for the event trace sent by trace_HHWardBook1.h
+ *
+ * This runs on a Linux PC, not on the PIC. Build it with
+ *      gcc -O2 -o traceTimeline traceTimeline.c
+ *
+ * and run it with a file that holds one or more traceDump () outputs captured from RC6
+ *      ./traceTimeline trace.bin
+ *      ./traceTimeline -l 3 2 trace.bin        (also the latency from event 3 to the next event 2)
+ *
+ * For each dump it prints a timeline, one line per event with the time from the first
+ * record, the time since the event before and the event name and argument. Then for each
+ * event id it prints a histogram of the time between one event and the next of the same
+ * id, in power of 2 buckets of microseconds, with the shortest, longest and average.
+ *
+ * Created on October 19, 2026
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define eventIds    256
+#define buckets     32              // Bucket n holds times from 2^(n-1) up to 2^n us
+#define cyclesPerUs 2.0             // Tcy = 0.5us at 8MHz
+
+static const char *eventNames [] =  // Same order as the ids in trace_HHWardBook1.h
+{
+    "overflow", "lcd command", "lcd data", "adc done", "phase", "button", "bus write"
+};
+
+typedef struct
+{
+    unsigned long long count, histogram [buckets];
+    double total, shortest, longest, last;
+} histogramType;
+
+static histogramType perId [eventIds], latency;
+static int latencyFrom = -1, latencyTo = -1;
+static double latencyStart = -1;
+
+static const char *eventName (int id)
+{
+    static char names [eventIds][12];   // One for each id so two names can be used in the same printf
+    if (id < (int) (sizeof eventNames / sizeof eventNames [0])) return eventNames [id];
+    sprintf (names [id & (eventIds - 1)], "event %d", id & (eventIds - 1));
+    return names [id & (eventIds - 1)];
+}
+
+static void histogramAdd (histogramType *h, double us)
+{
+    int bucket = 0;
+    while (bucket < buckets - 1 && us >= (double) (1ULL << bucket)) bucket ++;
+    h -> histogram [bucket] ++;
+    if (!h -> count || us < h -> shortest) h -> shortest = us;
+    if (us > h -> longest) h -> longest = us;
+    h -> total += us;
+    h -> count ++;
+}
+
+static void histogramPrint (const char *title, const histogramType *h)
+{
+    unsigned long long most = 0;
+    int bucket, n;
+    if (!h -> count) return;
+    printf ("\n%s: %llu intervals, shortest %.1f us, longest %.1f us, average %.1f us\n",
+            title, h -> count, h -> shortest, h -> longest, h -> total / h -> count);
+    for (bucket = 0; bucket < buckets; bucket ++)
+        if (h -> histogram [bucket] > most) most = h -> histogram [bucket];
+    for (bucket = 0; bucket < buckets; bucket ++)
+    {
+        if (!h -> histogram [bucket]) continue;
+        printf ("  < %10llu us %8llu ", 1ULL << bucket, h -> histogram [bucket]);
+        for (n = 0; n < (int) (50 * h -> histogram [bucket] / most); n ++) putchar ('#');
+        putchar ('\n');
+    }
+}
+
+static void traceDone (const unsigned char *records, int count, int dump)
+{
+    unsigned long long wraps = 0, cycles;
+    double us, first = -1, before = 0;
+    int n, id;
+
+    for (id = 0; id < eventIds; id ++) perId [id].last = -1;
+    latencyStart = -1;
+    printf ("dump %d, %d records\n%12s %12s  event\n", dump, count, "time us", "delta us");
+    for (n = 0; n < count; n ++, records += 4)
+    {
+        id = records [2];
+        if (id == 0) wraps += records [3];     // Timer 1 wrapped before this record
+        cycles = (wraps << 16) | (records [1] << 8) | records [0];
+        us = cycles / cyclesPerUs;
+        if (id == 0) continue;
+        if (first < 0) first = before = us;    // Times are from the first real event
+        printf ("%12.1f %12.1f  %-12s %3u (0x%02X)\n", us - first, us - before,
+                eventName (id), records [3], records [3]);
+        before = us;
+        if (perId [id].last >= 0) histogramAdd (&perId [id], us - perId [id].last);
+        perId [id].last = us;
+        if (id == latencyFrom && latencyStart < 0) latencyStart = us;
+        else if (id == latencyTo && latencyStart >= 0)
+        {
+            histogramAdd (&latency, us - latencyStart);
+            latencyStart = -1;
+        }
+    }
+}
+
+int main (int argc, char **argv)
+{
+    unsigned char header [3], records [255 * 4];
+    int arg = 1, dumps = 0, id;
+    FILE *in;
+
+    if (arg + 2 < argc && strcmp (argv [arg], "-l") == 0)
+    {
+        latencyFrom = atoi (argv [arg + 1]);
+        latencyTo = atoi (argv [arg + 2]);
+        arg += 3;
+    }
+    if (arg >= argc)
+    {
+        fprintf (stderr, "usage: %s [-l from to] <trace file>\n", argv [0]);
+        return 2;
+    }
+    in = fopen (argv [arg], "rb");
+    if (!in)
+    {
+        fprintf (stderr, "%s: %s\n", argv [arg], strerror (errno));
+        return 1;
+    }
+    header [0] = header [1] = 0;
+    while (fread (header + 2, 1, 1, in) == 1)  // Look for 'T', 'R' then the record count
+    {
+        if (header [0] == 'T' && header [1] == 'R')
+        {
+            int count = header [2];
+            if (fread (records, 4, count, in) != (size_t) count)
+            {
+                fprintf (stderr, "dump %d is cut short\n", dumps);
+                break;
+            }
+            traceDone (records, count, dumps ++);
+            header [0] = header [1] = header [2] = 0;
+            continue;
+        }
+        header [0] = header [1];
+        header [1] = header [2];
+    }
+    fclose (in);
+    for (id = 1; id < eventIds; id ++)
+    {
+        char title [40];
+        sprintf (title, "%s to %s", eventName (id), eventName (id));
+        histogramPrint (title, &perId [id]);
+    }
+    if (latencyFrom >= 0)
+    {
+        char title [80];
+        sprintf (title, "latency %s to %s", eventName (latencyFrom), eventName (latencyTo));
+        histogramPrint (title, &latency);
+    }
+    fprintf (stderr, "%d dumps\n", dumps);
+    return 0;
+}
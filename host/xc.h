@@ -0,0 +1,178 @@
+/*
+ * File:   xc.h
+ * Name: A stand in for XC8's xc.h so the book's programs build on a PC
+ *
+ * This runs on a Linux PC, not on the PIC. With -Ihost the programs' #include <xc.h>
+ * finds this file instead of the compiler's. The pins go through pins_HHWardBook1.h,
+ * built with PIN_HOST_BACKEND, to hostPinWrite and hostPinRead, and the time is moved on
+ * by hostDelayNs (see pinsVcd.h). Those come from host/pinsVcd.c or from a model such as
+ * host/lcdModel.c.
+ *
+ * The registers of the timers, CCP1, CCP2, the EUSART, the ADC, the data EEPROM and the
+ * interrupts are kept in hostSfrs and every access to one goes through hostTouch in
+ * host/picModel.h, which moves them on with the PIC time and runs the program's isr, so
+ * programs that poll TMR0IF, time with Timer 1 or wait for an interrupt, a conversion or
+ * an EEPROM write run as they do on the PIC. The other registers are ordinary variables:
+ * writing one does nothing and reading one gives what was last written. SSPSTAT's BF bit
+ * is always 1 so spiSend does not wait for a transfer that never comes, and the last byte
+ * written to SSPBUF is what a 595 model sees when its latch pin goes high.
+ *
+ * The registers are defined here, not just declared, so this must only be included by the
+ * one file that has main, which is how the book's programs are built anyway. The model
+ * uses the maths library, so build with -lm, e.g.
+ *      gcc -O2 -DPIN_HOST_BACKEND -Ihost -o traffic trafficLightMain.c host/pinsVcd.c -lm
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef XC_H
+#define XC_H
+
+#include "pinsVcd.h"
+
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"     // The #pragma config lines
+#define __interrupt(...)
+#define NOP()
+#define SLEEP()
+#define CLRWDT()
+#define ei()    (INTCONbits.GIE = 1)
+#define di()    (INTCONbits.GIE = 0)
+#ifndef __uint24
+#define __uint24 unsigned long
+#endif
+
+// The registers the model looks after. Each bits view shares its byte with the register,
+// as in XC8, and the 16-bit names share the low and high bytes.
+
+typedef struct
+{
+    union { unsigned char INTCON; union
+    {
+        struct { unsigned char RBIF:1, INT0IF:1, TMR0IF:1, RBIE:1, INT0IE:1, TMR0IE:1, PEIE:1, GIE:1; };
+        struct { unsigned char :1, INT0F:1, T0IF:1, :1, INT0E:1, T0IE:1, GIEL:1, GIEH:1; };
+        struct { unsigned char :6, PEIE_GIEL:1, GIE_GIEH:1; };
+    } INTCONbits; };
+    union { unsigned char PIR1; struct { unsigned char TMR1IF:1, TMR2IF:1, CCP1IF:1, SSPIF:1, TXIF:1, RCIF:1, ADIF:1, PSPIF:1; } PIR1bits; };
+    union { unsigned char PIE1; struct { unsigned char TMR1IE:1, TMR2IE:1, CCP1IE:1, SSPIE:1, TXIE:1, RCIE:1, ADIE:1, PSPIE:1; } PIE1bits; };
+    union { unsigned char PIR2; struct { unsigned char CCP2IF:1, TMR3IF:1, HLVDIF:1, BCLIF:1, EEIF:1, :1, CMIF:1, OSCFIF:1; } PIR2bits; };
+    union { unsigned char PIE2; struct { unsigned char CCP2IE:1, TMR3IE:1, HLVDIE:1, BCLIE:1, EEIE:1, :1, CMIE:1, OSCFIE:1; } PIE2bits; };
+    union { unsigned char T0CON; struct { unsigned char T0PS:3, PSA:1, T0SE:1, T0CS:1, T08BIT:1, TMR0ON:1; } T0CONbits; };
+    union { unsigned char T1CON; struct { unsigned char TMR1ON:1, TMR1CS:1, NOT_T1SYNC:1, T1OSCEN:1, T1CKPS:2, T1RUN:1, RD16:1; } T1CONbits; };
+    union { unsigned char T3CON; struct { unsigned char TMR3ON:1, TMR3CS:1, NOT_T3SYNC:1, T3CCP1:1, T3CKPS:2, T3CCP2:1, RD16:1; } T3CONbits; };
+    union { unsigned short TMR0; struct { unsigned char TMR0L, TMR0H; }; };
+    union { unsigned short TMR1; struct { unsigned char TMR1L, TMR1H; }; };
+    union { unsigned short TMR3; struct { unsigned char TMR3L, TMR3H; }; };
+    union { unsigned char CCP1CON; struct { unsigned char CCP1M:4, DC1B:2, :2; } CCP1CONbits; };
+    union { unsigned short CCPR1; struct { unsigned char CCPR1L, CCPR1H; }; };
+    union { unsigned char CCP2CON; struct { unsigned char CCP2M:4, DC2B:2, :2; } CCP2CONbits; };
+    union { unsigned short CCPR2; struct { unsigned char CCPR2L, CCPR2H; }; };
+    union { unsigned char TXSTA; struct { unsigned char TX9D:1, TRMT:1, BRGH:1, SENDB:1, SYNC:1, TXEN:1, TX9:1, CSRC:1; } TXSTAbits; };
+    union { unsigned char RCSTA; struct { unsigned char RX9D:1, OERR:1, FERR:1, ADDEN:1, CREN:1, SREN:1, RX9:1, SPEN:1; } RCSTAbits; };
+    union { unsigned char BAUDCON; struct { unsigned char ABDEN:1, WUE:1, :1, BRG16:1, TXCKP:1, RXDTP:1, RCIDL:1, ABDOVF:1; } BAUDCONbits; };
+    unsigned char SPBRG, SPBRGH;
+    union { unsigned char ADCON0; union
+    {
+        struct { unsigned char ADON:1, GO_DONE:1, CHS:4, :2; };
+        struct { unsigned char :1, GO:1, CHS0:1, CHS1:1, CHS2:1, CHS3:1, :2; };
+        struct { unsigned char :1, GODONE:1, :6; };
+        struct { unsigned char :1, DONE:1, :6; };
+        struct { unsigned char :1, NOT_DONE:1, :6; };
+    } ADCON0bits; };
+    union { unsigned char ADCON1; struct { unsigned char PCFG:4, VCFG0:1, VCFG1:1, :2; } ADCON1bits; };
+    union { unsigned char ADCON2; struct { unsigned char ADCS:3, ACQT:3, :1, ADFM:1; } ADCON2bits; };
+    union { unsigned short ADRES; struct { unsigned char ADRESL, ADRESH; }; };
+    union { unsigned char EECON1; struct { unsigned char RD:1, WR:1, WREN:1, WRERR:1, FREE:1, :1, CFGS:1, EEPGD:1; } EECON1bits; };
+    unsigned char EEADR, EEADRH, EEDATA;
+    unsigned short EECON2;          // Write only, as TXREG
+    unsigned short TXREG;           // Write only, 0xFFFF until the program writes a byte so the same byte twice is seen
+} hostSfrsType;
+
+volatile hostSfrsType hostSfrs = { .T0CON = 0xFF, .TXSTA = 0x02, .TXREG = 0xFFFF, .EECON2 = 0xFFFF };     // The values at reset
+
+volatile void *hostTouch (volatile void *sfr);
+#include "picModel.h"
+
+#define hostSfr(name)   (*(__typeof__ (hostSfrs.name) *) hostTouch (&hostSfrs.name))
+#define INTCON          hostSfr (INTCON)
+#define INTCONbits      hostSfr (INTCONbits)
+#define PIR1            hostSfr (PIR1)
+#define PIR1bits        hostSfr (PIR1bits)
+#define PIE1            hostSfr (PIE1)
+#define PIE1bits        hostSfr (PIE1bits)
+#define PIR2            hostSfr (PIR2)
+#define PIR2bits        hostSfr (PIR2bits)
+#define PIE2            hostSfr (PIE2)
+#define PIE2bits        hostSfr (PIE2bits)
+#define T0CON           hostSfr (T0CON)
+#define T0CONbits       hostSfr (T0CONbits)
+#define T1CON           hostSfr (T1CON)
+#define T1CONbits       hostSfr (T1CONbits)
+#define T3CON           hostSfr (T3CON)
+#define T3CONbits       hostSfr (T3CONbits)
+#define TMR0            hostSfr (TMR0)
+#define TMR0L           hostSfr (TMR0L)
+#define TMR0H           hostSfr (TMR0H)
+#define TMR1            hostSfr (TMR1)
+#define TMR1L           hostSfr (TMR1L)
+#define TMR1H           hostSfr (TMR1H)
+#define TMR3            hostSfr (TMR3)
+#define TMR3L           hostSfr (TMR3L)
+#define TMR3H           hostSfr (TMR3H)
+#define CCP1CON         hostSfr (CCP1CON)
+#define CCP1CONbits     hostSfr (CCP1CONbits)
+#define CCPR1           hostSfr (CCPR1)
+#define CCPR1L          hostSfr (CCPR1L)
+#define CCPR1H          hostSfr (CCPR1H)
+#define CCP2CON         hostSfr (CCP2CON)
+#define CCP2CONbits     hostSfr (CCP2CONbits)
+#define CCPR2           hostSfr (CCPR2)
+#define CCPR2L          hostSfr (CCPR2L)
+#define CCPR2H          hostSfr (CCPR2H)
+#define TXSTA           hostSfr (TXSTA)
+#define TXSTAbits       hostSfr (TXSTAbits)
+#define RCSTA           hostSfr (RCSTA)
+#define RCSTAbits       hostSfr (RCSTAbits)
+#define BAUDCON         hostSfr (BAUDCON)
+#define BAUDCONbits     hostSfr (BAUDCONbits)
+#define SPBRG           hostSfr (SPBRG)
+#define SPBRGH          hostSfr (SPBRGH)
+#define TXREG           hostSfr (TXREG)
+#define ADCON0          hostSfr (ADCON0)
+#define ADCON0bits      hostSfr (ADCON0bits)
+#define ADCON1          hostSfr (ADCON1)
+#define ADCON1bits      hostSfr (ADCON1bits)
+#define ADCON2          hostSfr (ADCON2)
+#define ADCON2bits      hostSfr (ADCON2bits)
+#define ADRES           hostSfr (ADRES)
+#define ADRESL          hostSfr (ADRESL)
+#define ADRESH          hostSfr (ADRESH)
+#define EECON1          hostSfr (EECON1)
+#define EECON1bits      hostSfr (EECON1bits)
+#define EECON2          hostSfr (EECON2)
+#define EEADR           hostSfr (EEADR)
+#define EEADRH          hostSfr (EEADRH)
+#define EEDATA          hostSfr (EEDATA)
+
+// The rest are ordinary variables
+
+#define hostPort(P) volatile unsigned char PORT##P, LAT##P, TRIS##P; \
+    volatile struct { unsigned R##P##0:1, R##P##1:1, R##P##2:1, R##P##3:1, R##P##4:1, R##P##5:1, R##P##6:1, R##P##7:1; } PORT##P##bits; \
+    volatile struct { unsigned LAT##P##0:1, LAT##P##1:1, LAT##P##2:1, LAT##P##3:1, LAT##P##4:1, LAT##P##5:1, LAT##P##6:1, LAT##P##7:1; } LAT##P##bits; \
+    volatile struct { unsigned TRIS##P##0:1, TRIS##P##1:1, TRIS##P##2:1, TRIS##P##3:1, TRIS##P##4:1, TRIS##P##5:1, TRIS##P##6:1, TRIS##P##7:1; } TRIS##P##bits;
+
+hostPort (A)
+hostPort (B)
+hostPort (C)
+hostPort (D)
+hostPort (E)
+
+volatile unsigned char OSCCON, OSCTUNE, T2CON, TMR2, PR2, INTCON2, INTCON3, IPR1, IPR2,
+    RCON, RCREG, SSPSTAT, SSPCON1, SSPCON2, SSPBUF, SSPADD,
+    PRODL, PRODH, WREG, STATUS;
+volatile unsigned short PROD;
+volatile struct { unsigned BF:1, UA:1, R_W:1, S:1, P:1, D_A:1, CKE:1, SMP:1; } SSPSTATbits = {.BF = 1};
+volatile struct { unsigned SSPM:4, CKP:1, SSPEN:1, SSPOV:1, WCOL:1; } SSPCON1bits;
+volatile struct { unsigned IRCF:3, :4, IDLEN:1; } OSCCONbits;
+volatile struct { unsigned NOT_BOR:1, NOT_POR:1, NOT_PD:1, NOT_TO:1, NOT_RI:1, :1, SBOREN:1, IPEN:1; } RCONbits;
+
+#endif
@@ -0,0 +1,314 @@
+/*
+ * File:   lcd4Bit_HHWardBook1.h
+ * Name: 4-bit LCD subroutines shared by the programs
+ *
+ * These are the LCD subroutines from VoltMeter_main.c moved into one file so a program
+ * only has to include them. SpecCharProg_main.c still has its own copies, as printed in
+ * the book. The program must define _XTAL_FREQ before including this file as the
+ * subroutines use __delay_ms.
+ *
+ * The LCD can be connected in one of two ways:
+ *
+ * 1. Directly to PORTB (the default, as on the matrix multimedia board)
+ *      RB0 to RB3 = D4 to D7, RB4 = RS, RB5 = E
+ *
+ * 2. Through a 74HC595 shift register driven by the MSSP in SPI mode. Define LCD_SPI
+ *    before including this file. Only three pins are used:
+ *      RC3 = SCK   -> 595 SRCLK (pin 11)
+ *      RC5 = SDO   -> 595 SER   (pin 14)
+ *      RC0 = latch -> 595 RCLK  (pin 12)
+ *    The 595 outputs are wired the same way as PORTB above, QA to QD = D4 to D7,
+ *    QE = RS and QF = E, so the same byte that would go to PORTB is shifted out.
+ *
+ * Instruction cycles to deliver one nibble to the LCD (Tcy = 0.5us at 8MHz):
+ *
+ *      Direct PORTB        MOVFF to LATB, BSF E, BCF E                     4 Tcy
+ *      SPI to the 595      3 transfers (RS/data, E high, E low), each:
+ *                          MOVFF to SSPBUF 2, wait 8 bits at Fosc/4 8,
+ *                          MOVF SSPBUF 1, latch pulse 2                   39 Tcy
+ *      595 bit-banged      3 transfers of 8 x (test, set SER, pulse SRCLK)
+ *                          about 40 Tcy each                             120 Tcy
+ *
+ * So the MSSP does the serialising and is three times cheaper than shifting the
+ * bits out in software, but it does cost more than the direct port. Both are small
+ * next to the __delay_ms(3) after every nibble (6000 Tcy). The saving is the pins:
+ * PORTB is free for other jobs. host/lcdCheck.c measures the first two against a model
+ * of the 595 and the LCD on a PC.
+ *
+ * The size of the LCD is set by defining lcdColumns and lcdRows before including this
+ * file, 16 x 2 if nothing is defined. The lines of an LCD do not follow on from each
+ * other in the DDRAM, e.g. on a 20 x 4 LCD line 3 starts at 0x14 straight after the
+ * end of line 1. lcdRowStart holds where each line starts for the size chosen, so
+ * lcdGotoXY can put the cursor on any character with one instruction byte:
+ *
+ *      16 x 2      0x00 0x40
+ *      16 x 4      0x00 0x40 0x10 0x50
+ *      20 x 2      0x00 0x40
+ *      20 x 4      0x00 0x40 0x14 0x54
+ *      40 x 2      0x00 0x40
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef LCD4BIT_HHWARDBOOK1_H
+#define LCD4BIT_HHWARDBOOK1_H
+
+#include "pins_HHWardBook1.h"
+#include "profile_HHWardBook1.h"
+#include "trace_HHWardBook1.h"
+
+// The LCD instructions
+#define firstbyte 0b00110011        // The first instruction to be send to the LCD
+#define secondbyte 0b00110011       // The second instruction to be send to the LCD
+#define fourBitOp   0b00110010      // Sets LCD for 4-bit operation instead of 8
+#define twoLines    0b00101100      // Sets the LCD to 2 line mode
+#define oneLine     0b00100000      // Sets the LCD to 1 line mode, for an LCD with only one line
+#define incPosition 0b00000110      // Tells the LCD to increment the cursor position after any data is displayed
+#define cursorNoBlink   0b00001100  // Turns the cursor off so we don't see it flashing
+#define clearScreen 0b00000001      // Clears the screen of all display
+#define returnHome  0b00000010      // Sends the cursor back to the start position on the display
+#define lineTwo 0b11000000          // Sends the cursor to the start of line 2 on the display
+#define doBlink 0b00001111          // Turns the cursor on and makes it blink
+#define shiftLeft   0b00010000      // Shifts the cursor one position to the left
+#define shiftRight  0b00010100      // Shifts the cursor one position to the right
+#define displayLeft 0b00011000      // Shifts the whole display one position to the left, the cursor goes with it
+#define displayRight 0b00011100     // Shifts the whole display one position to the right
+
+// Where the LCD is connected
+#ifndef LCD_SPI
+#define lcdPort B                   // Sets which port the LCD is connected to
+#define eBit    B,5                 // Sets the bit for the E pin on the LCD
+#define rspin   B,4                 // Sets the bit for the RS pin on the LCD
+#else
+#define lcdLatch C,0                // Sets the bit for the RCLK (latch) pin of the 595
+#define eMask   0b00100000          // The 595 output (QF) used for the E pin on the LCD
+#endif
+
+// The waits after sending to the LCD, they can be set before including this file to try other values
+#ifndef lcdNibbleMs
+#define lcdNibbleMs 3               // After every nibble in sendData, the book's value
+#endif
+#ifndef lcdQuickUs
+#define lcdQuickUs  50              // After each byte in lcdOutQuick, the LCD needs 37us
+#endif
+
+// The size of the LCD
+#ifndef lcdColumns
+#define lcdColumns  16              // Characters across each line
+#define lcdRows     2               // Number of lines
+#endif
+
+#if lcdRows == 4 && lcdColumns == 20
+const unsigned char lcdRowStart [4] = {0x00, 0x40, 0x14, 0x54};    // DDRAM address at the start of each line
+#elif lcdRows == 4 && lcdColumns == 16
+const unsigned char lcdRowStart [4] = {0x00, 0x40, 0x10, 0x50};
+#elif lcdRows == 2 && (lcdColumns == 16 || lcdColumns == 20 || lcdColumns == 40)
+const unsigned char lcdRowStart [2] = {0x00, 0x40};
+#elif lcdRows == 1 && (lcdColumns == 16 || lcdColumns == 20 || lcdColumns == 40)
+const unsigned char lcdRowStart [1] = {0x00};
+#else
+#error "lcdColumns x lcdRows is not a supported LCD size"
+#endif
+
+// Some variables
+unsigned char lcdData, lcdTempData, rsLine; // Declare some variables as unsigned char
+unsigned char cursorCol, cursorRow;         // Where writeString will put the next character
+
+char lcdInitialize [8] =    // Creates an array of 8 locations long and loads each location with the following data
+{
+    firstbyte,
+    secondbyte,
+    fourBitOp,
+#if lcdRows > 1
+    twoLines,
+#else
+    oneLine,
+#endif
+    incPosition,
+    cursorNoBlink,
+    clearScreen,
+    returnHome,
+};
+
+// The subroutines
+
+#ifdef LCD_SPI
+
+void spiSetUp ()                // Sets the MSSP up as an SPI master to drive the 595
+{
+    TRISCbits.TRISC3 = 0;       // SCK is an output
+    TRISCbits.TRISC5 = 0;       // SDO is an output
+    TRISCbits.TRISC0 = 0;       // The latch pin is an output
+    pinLow (lcdLatch);
+    SSPSTAT = 0b01000000;       // CKE = 1 so SDO changes on the falling edge of SCK and the 595 reads it on the rising edge
+    SSPCON1 = 0b00100000;       // SSPEN = 1 turns the MSSP on, SPI master with clock = FOSC/4 i.e. 2MHz
+}
+
+void spiSend (unsigned char info)   // Shifts one byte out to the 595 and copies it to the 595 outputs
+{
+    SSPBUF = info;              // Loading SSPBUF starts the transfer, the MSSP shifts the 8 bits out by itself
+    while (!SSPSTATbits.BF);    // Wait for the 8 bits to be sent, this takes 8 instruction cycles
+    info = SSPBUF;              // Reading SSPBUF clears the BF flag ready for the next byte
+    pinHigh (lcdLatch);         // A rising edge on RCLK copies the shift register to the outputs
+    pinLow (lcdLatch);
+}
+
+#endif
+
+void sendNibble ()                  // Sends the top nibble of lcdTempData to the LCD, no delay afterwards
+{
+    lcdTempData = (lcdTempData << 4 | lcdTempData >> 4);    // Swaps the nibbles around in lcdTempData ready to send to the LCD
+    lcdData = lcdTempData & 0x0F;                           // Basically ignores the last four bits of the lcdTempData
+    lcdData = lcdData | rsLine;                             // Allows us to determine if the info is an instruction or data
+#ifndef LCD_SPI
+    portWrite (lcdPort, lcdData);                           // Send the info to the LCD
+    pinHigh (eBit);                                         // Next two instructions are to tell the LCD new data has arrived and it should deal with it
+    pinLow (eBit);
+#else
+    spiSend (lcdData);                                      // Set up RS and the data with E low
+    spiSend (lcdData | eMask);                              // Take E high
+    spiSend (lcdData);                                      // and low again so the LCD reads the info
+#endif
+}
+
+void sendData ()
+{
+    profileEnter (probeSendData);
+    sendNibble ();
+    __delay_ms(lcdNibbleMs);
+    profileExit (probeSendData);
+}
+
+void lcdOut ()
+{
+    profileEnter (probeLcdOut);
+    traceEvent (rsLine ? traceLcdData : traceLcdCommand, lcdData);
+    lcdTempData = lcdData;      // Store the information in a temporary location
+    sendData ();                // Sends the high nibble of the information to the LCD
+    sendData ();                // Sends the low nibble of the information to the LCD
+    profileExit (probeLcdOut);
+}
+
+void lcdOutQuick ()             // Same as lcdOut but only waits 50us, for data and instructions that take 37us
+{                               // Note: not for clearScreen and returnHome, they take 1.52ms
+    traceEvent (rsLine ? traceLcdData : traceLcdCommand, lcdData);
+    lcdTempData = lcdData;
+    sendNibble ();              // The LCD does not need any time between the two nibbles
+    sendNibble ();
+    __delay_us(lcdQuickUs);
+}
+
+void setUpTheLCD ()
+{
+    unsigned char n;
+#ifdef LCD_SPI
+    spiSetUp ();                // The MSSP must be running before anything can go to the LCD
+#endif
+    __delay_ms(32);
+    rsLine = 0x00;              // Ensures bit-4 or the RS pin will be logic '0' as these are instructions
+    lcdTempData = firstbyte;    // The first 0x3 needs 4.1ms, longer than sendData waits, so it is sent on its own
+    sendNibble ();
+    __delay_us(4100);
+    sendData ();                // then the second 0x3 as the book does
+    n=1;                        // Makes variable n = 1 ready for the while loop upcoming, firstbyte has gone
+    while (n <8)
+    {
+        lcdData = lcdInitialize [n];    // Load the variable lcdData with particular contents of the memory location in the array
+                                        // lcdInitiazlize the pointer is currently pointing to
+        lcdOut ();                      // Send that information to the LCD
+        n ++;
+    }
+    rsLine = 0x10;                      // Ensures bit-4 of the rsLine is a logic 1 for data
+    cursorCol = 0;                      // The last instruction was returnHome
+    cursorRow = 0;
+}
+
+void setUpTheLCDQuick ()            // Same as setUpTheLCD but each instruction only waits as long as the data sheet says
+{                                   // Note: no power on wait, the program must make sure 32ms have gone since reset
+    unsigned char n, slow;
+#ifdef LCD_SPI
+    spiSetUp ();
+#endif
+    rsLine = 0x00;
+    lcdTempData = firstbyte;        // The reset sequence is sent a nibble at a time, the LCD is still in 8-bit mode
+    sendNibble ();
+    __delay_us(4100);               // The first 0x3 needs 4.1ms
+    sendNibble ();
+    __delay_us(100);                // the second 100us
+    lcdTempData = secondbyte;
+    sendNibble ();
+    __delay_us(40);                 // and the rest 37us
+    sendNibble ();
+    __delay_us(40);
+    lcdTempData = fourBitOp;
+    sendNibble ();
+    __delay_us(40);
+    sendNibble ();                  // After this 0x2 the LCD is in 4-bit mode
+    __delay_us(40);
+    n = 3;
+    while (n < 8)                   // The rest of lcdInitialize are ordinary 4-bit instructions
+    {
+        lcdData = lcdInitialize [n];
+        slow = lcdData < 0x04;      // clearScreen and returnHome take 1.52ms
+        lcdOutQuick ();
+        if (slow) __delay_us(1600);
+        n ++;
+    }
+    rsLine = 0x10;
+    cursorCol = 0;
+    cursorRow = 0;
+}
+
+void lcdGotoXY (unsigned char col, unsigned char row)  // Moves the cursor to any character with one instruction
+{
+    if (row >= lcdRows) row = lcdRows - 1;      // Off the LCD goes to the nearest character on it, lcdRowStart only has lcdRows entries
+    if (col >= lcdColumns) col = lcdColumns - 1;
+    rsLine = 0x00;                      // Ensures bit 4 or the RS pin will be logic 0 as these are instructions
+    lcdData = 0x80 | (lcdRowStart [row] + col);    // 0x80 is the set DDRAM address instruction
+    lcdOut ();
+    rsLine = 0x10;                      // Ensures bit 4 of the rsLine is a logic 1 for data
+    cursorCol = col;
+    cursorRow = row;
+}
+
+void line2 ()
+{
+    rsLine = 0x00;                      // Ensures bit 4 or the RS pin will be logic 0 as these are instructions
+    lcdData = lineTwo;
+    lcdOut ();
+    rsLine = 0x10;                      // Ensures bit 4 of the rsLine is a logic 1 for data
+    cursorCol = 0;
+    cursorRow = 1;
+}
+
+void clearTheScreen ()
+{
+    rsLine = 0x00;                      // Ensures bit 4 or the RS pin will be logic 0 as these are instructions
+    lcdData = clearScreen;              // Loads the variable lcdData with the instruction to clear the screen
+    lcdOut ();                          // Sends the instruction to the LCD
+    lcdData = returnHome;               // Loads the variable lcdData with the instruction to return the cursor to the home position
+    lcdOut ();                          // Sends the instruction to the LCD
+    rsLine = 0x10;                      // Ensures bit 4 of the rsLine is a logic 1 for data
+    cursorCol = 0;
+    cursorRow = 0;
+}
+
+void writeString (const char *words)  // Writes from the cursor, carries on at the start of the next line and stops after the last line
+{
+    profileEnter (probeWriteString);
+    while (*words)          // While the *words pointer is not pointing to the NULL char do what is inside the brackets
+    {
+        if (cursorCol >= lcdColumns)            // Gone past the end of the line
+        {
+            if (cursorRow + 1 >= lcdRows) break;    // No more lines so the rest of the string is not shown
+            lcdGotoXY (0, cursorRow + 1);
+        }
+        lcdData = *words;   // Load what the *words pointer is pointing to into the variable lcdData
+        lcdOut ();          // Call the subroutine to pass the data to the LCD
+        cursorCol ++;
+        words ++;           // Increment the pointer so that it is pointing to the next char in the array
+    }
+    profileExit (probeWriteString);
+}
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ * File:   lcdBar_HHWardBook1.h
+ * Name: An 80 step bar graph on one line of the LCD
+ *
+ * Each character is 5 dots wide so 16 characters make a bar of 80 columns. Four special
+ * characters are put into CGRAM (the same way writeToGram does in SpecCharProg_main.c)
+ * with 1 to 4 of their columns filled. The LCD's own full block (0xFF) is used for 5 and
+ * a space for none:
+ *
+ *      CGRAM 1     #....       CGRAM 3     ###..
+ *      CGRAM 2     ##...       CGRAM 4     ####.
+ *
+ * barShow only sends the characters that are different from what is already showing:
+ * when the bar moves by a few columns that is the one or two characters at its end, one
+ * instruction to put the cursor there and one or two bytes, about 150us with lcdOutQuick.
+ * Only a big jump needs more, up to the whole line. barForget makes the next barShow
+ * write the whole bar, for when the line has been written over.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef LCDBAR_HHWARDBOOK1_H
+#define LCDBAR_HHWARDBOOK1_H
+
+#include "lcd4Bit_HHWardBook1.h"
+
+#define barCells    16              // Characters in the bar
+#define barColumns  (barCells * 5)  // 80 steps
+#define barUnknown  0xFF            // barLength when what is on the LCD is not known
+#define barFull     0xFF            // The full block in the LCD's character set
+
+// Some variables
+unsigned char barLength = barUnknown;   // Columns showing at the moment
+
+// The subroutines
+
+void barSetUp ()                    // Writes the 4 part filled characters into CGRAM 1 to 4
+{
+    unsigned char code, row, dots;
+    rsLine = 0x00;
+    lcdData = 0x40 + 8;             // Set CGRAM address, character 1 starts at 8
+    lcdOutQuick ();
+    rsLine = 0x10;
+    dots = 0b00010000;              // The left hand column
+    code = 1;
+    while (code < 5)
+    {
+        row = 0;
+        while (row < 8)
+        {
+            lcdData = row == 7 ? 0 : dots;  // The bottom row is left clear, like the cursor line
+            lcdOutQuick ();
+            row ++;
+        }
+        dots = dots >> 1 | 0b00010000;  // One more column for the next character
+        code ++;
+    }
+    barLength = barUnknown;         // So the next barShow writes the whole bar
+}
+
+unsigned char barCell (unsigned char cell, unsigned char length)   // The character for one cell of a bar length columns long
+{
+    unsigned char start;
+    start = cell * 5;
+    if (length <= start) return ' ';
+    if (length >= start + 5) return barFull;
+    return length - start;          // CGRAM 1 to 4
+}
+
+void barShow (unsigned char length, unsigned char address)  // Shows a bar length columns long, address is the DDRAM address of its first cell
+{
+    unsigned char first, last, cell;
+    if (length > barColumns) length = barColumns;
+    if (length == barLength) return;
+    if (barLength == barUnknown)
+    {
+        first = 0;                  // Write all of it
+        last = barCells - 1;
+    }
+    else
+    {
+        first = (length < barLength ? length : barLength) / 5;     // The cells between the old and new ends
+        last = ((length > barLength ? length : barLength) - 1) / 5;
+    }
+    rsLine = 0x00;
+    lcdData = 0x80 | (address + first);    // Set DDRAM address
+    lcdOutQuick ();
+    rsLine = 0x10;
+    cell = first;
+    while (cell <= last)            // The cursor moves on by itself after each one
+    {
+        lcdData = barCell (cell, length);
+        lcdOutQuick ();
+        cell ++;
+    }
+    barLength = length;
+}
+
+void barForget ()                   // The bar's line has been written over, the next barShow writes all of it
+{
+    barLength = barUnknown;
+}
+
+#endif
@@ -0,0 +1,79 @@
+/*
+ * File:   lcdMarquee_HHWardBook1.h
+ * Name: Scrolling a long message with the LCD display shift instruction
+ *
+ * Each line of the LCD has 40 characters of DDRAM but only the first 16 can be seen.
+ * The whole message (up to 40 characters) is written into the DDRAM once. After that
+ * the display shift instruction (displayLeft) moves the 16 character window along the
+ * 40 characters, so every scroll step is a single instruction byte. The DDRAM wraps
+ * around at 40 so the message keeps going round without ever being sent again.
+ *
+ * Bytes sent to the LCD for each scroll step:
+ *
+ *      Rewriting the visible line      1 address + 16 characters   17 bytes  102ms
+ *      Display shift (this file)       1 instruction                1 byte     6ms
+ *
+ * (the times are for lcdOut with its 3ms delay after each nibble)
+ *
+ * Note: the display shift moves both lines together, so the other line must either
+ * hold a message of its own or be written into all 40 of its columns.
+ *
+ * The steps are timed with Timer 0, set up as in the book with T0CON = 0xC7. It then
+ * overflows every 32.8ms (256 x 128us) and marqueeTick () counts the overflows.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef LCDMARQUEE_HHWARDBOOK1_H
+#define LCDMARQUEE_HHWARDBOOK1_H
+
+#include "lcd4Bit_HHWardBook1.h"
+
+#define ddramWidth  40              // Characters of DDRAM on each line
+
+// Some variables
+unsigned char marqueeSpeed;         // Timer 0 overflows between each scroll step
+unsigned char marqueeCount;         // Timer 0 overflows since the last scroll step
+
+// The subroutines
+
+void marqueeStart (const char *message, unsigned char row, unsigned char speed)  // Writes the message into all 40 columns of a line
+{
+    unsigned char n;
+    rsLine = 0x00;                  // Instructions
+    lcdData = returnHome;           // Puts the display shift back to 0 so column 0 is at the left
+    lcdOut ();
+    lcdData = row ? lineTwo : 0x80; // Sets the DDRAM address to the start of the line
+    lcdOut ();
+    rsLine = 0x10;                  // Data
+    n = 0;
+    while (n < ddramWidth)          // Writes the message and then spaces up to column 39
+    {
+        if (*message)
+        {
+            lcdData = *message;
+            message ++;
+        }
+        else lcdData = ' ';
+        lcdOut ();
+        n ++;
+    }
+    marqueeSpeed = speed;
+    marqueeCount = 0;
+    INTCONbits.TMR0IF = 0;          // Start timing the first step from now
+}
+
+void marqueeTick ()                 // Call this in the main loop, it scrolls the display one place every marqueeSpeed overflows
+{
+    if (!INTCONbits.TMR0IF) return; // Nothing to do until Timer 0 overflows
+    INTCONbits.TMR0IF = 0;
+    marqueeCount ++;
+    if (marqueeCount < marqueeSpeed) return;
+    marqueeCount = 0;
+    rsLine = 0x00;
+    lcdData = displayLeft;          // The one byte that scrolls the whole line
+    lcdOut ();
+    rsLine = 0x10;
+}
+
+#endif
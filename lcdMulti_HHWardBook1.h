@@ -0,0 +1,190 @@
+/*
+ * File:   lcdMulti_HHWardBook1.h
+ * Name: Driving several LCDs from one shared data bus
+ *
+ * All the LCDs share RB0 to RB3 (D4 to D7) and RB4 (RS). Each LCD has its own E pin,
+ * LCD 0 on RD0, LCD 1 on RD1 and so on. An LCD only reads the bus when its own E pin
+ * is pulsed, so the other LCDs ignore whatever is on the bus.
+ *
+ * The programs in the book wait a fixed time after every byte (__delay_ms) and do
+ * nothing while the LCD is busy. Here every byte for an LCD is put in a queue for that
+ * LCD and lcdMultiService () sends the next byte to each LCD that has finished its last
+ * instruction. While LCD 0 is busy with a byte LCD 1 is being given its byte, so two
+ * LCDs take about the same time to fill as one.
+ *
+ * Timer 1 counts instruction cycles (0.5us at 8MHz) and is used to know when each LCD
+ * will be ready again. Most instructions and all data take 37us, clear and home take
+ * 1.52ms (see the HD44780 data sheet). The ticks since the last byte are compared
+ * without a sign, which is right for 32ms after it, and once an LCD is found ready it
+ * is marked not busy so Timer 1 going round cannot make it look busy again.
+ *
+ * The program must define _XTAL_FREQ before including this file and can define
+ * lcdDisplays (1 to 4) to say how many LCDs there are.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef LCDMULTI_HHWARDBOOK1_H
+#define LCDMULTI_HHWARDBOOK1_H
+
+#include "lcd4Bit_HHWardBook1.h"
+
+#ifndef lcdDisplays
+#define lcdDisplays 2               // How many LCDs are on the bus
+#endif
+#define lcdQueueSize 40             // How many bytes can wait to go to each LCD
+#define lcdBus      B,0x1F          // RB0 to RB3 are D4 to D7, RB4 is RS, shared by all the LCDs
+#define lcdEPins    D,0x0F          // RD0 to RD3 are the E pins of LCD 0 to LCD 3
+#ifndef lcdShortTicks
+#define lcdShortTicks   100         // 50us in Timer 1 ticks, longer than the 37us most instructions take
+#endif
+#ifndef lcdLongTicks
+#define lcdLongTicks    3300        // 1.65ms in Timer 1 ticks, for the clear and home instructions
+#endif
+
+// Some variables
+unsigned char lcdQueue [lcdDisplays][lcdQueueSize];     // The bytes waiting to go to each LCD
+unsigned char lcdQueueRs [lcdDisplays][lcdQueueSize];   // 0x10 if the byte is data, 0x00 if it is an instruction
+unsigned char lcdHead [lcdDisplays], lcdTail [lcdDisplays]; // Where the next byte goes in and comes out of each queue
+unsigned int lcdSentAt [lcdDisplays];       // The Timer 1 count when each LCD was sent its last byte
+unsigned int lcdWait [lcdDisplays];         // and how many ticks that byte takes
+unsigned char lcdBusy [lcdDisplays];        // 1 until that many ticks have gone, then an idle LCD stays ready however long it waits
+unsigned char lcdCol [lcdDisplays], lcdRow [lcdDisplays];   // Where the cursor of each LCD is
+unsigned long lcdBytesSent;                 // Total bytes sent to all the LCDs, used for measuring the throughput
+
+// The subroutines
+
+unsigned int lcdMultiNow ()         // Reads Timer 1. With RD16 set reading TMR1L also copies the top byte to TMR1H
+{
+    unsigned char low;
+    low = TMR1L;
+    return ((unsigned int) TMR1H << 8) | low;
+}
+
+void lcdMultiNibble (unsigned char eMask, unsigned char nibble, unsigned char rs)  // Sends 4 bits to the LCDs in eMask
+{
+    portWriteMasked (lcdBus, nibble | rs);          // The nibble and RS go out together
+    portWriteMasked (lcdEPins, eMask);              // Pulse the E pins of the LCDs that should take it
+    portWriteMasked (lcdEPins, 0x00);
+}
+
+void lcdMultiSend (unsigned char eMask, unsigned char info, unsigned char rs)  // Sends a whole byte, only once the LCDs are in 4-bit mode
+{
+    lcdMultiNibble (eMask, info >> 4, rs);          // High nibble first
+    lcdMultiNibble (eMask, info & 0x0F, rs);        // then the low nibble
+}
+
+void lcdMultiSetUp ()               // Sets up every LCD at the same time by pulsing all the E pins together
+{
+    unsigned char n, all;
+    T1CON = 0b10000001;             // RD16 = 1, 1:1 prescale, internal clock, Timer 1 on so it counts instruction cycles
+    all = (1 << lcdDisplays) - 1;   // Every LCD gets the same set up instructions
+    __delay_ms(32);
+    lcdMultiNibble (all, 0x03, 0x00);   // The LCDs are still in 8-bit mode, so each nibble is a whole instruction
+    __delay_us(4100);               // The first 0x3 needs 4.1ms
+    lcdMultiNibble (all, 0x03, 0x00);
+    __delay_us(100);                // the second 100us
+    lcdMultiNibble (all, 0x03, 0x00);
+    __delay_us(40);                 // and the rest 37us
+    lcdMultiNibble (all, 0x03, 0x00);
+    __delay_us(40);
+    lcdMultiNibble (all, 0x03, 0x00);
+    __delay_us(40);
+    lcdMultiNibble (all, 0x02, 0x00);   // After this 0x2 the LCDs are in 4-bit mode
+    __delay_us(40);
+    n = 3;
+    while (n < 8)                   // The rest of lcdInitialize are ordinary 4-bit instructions, the same as setUpTheLCDQuick
+    {
+        lcdMultiSend (all, lcdInitialize [n], 0x00);
+        if (lcdInitialize [n] < 0x04) __delay_us(1600);     // clearScreen and returnHome take 1.52ms
+        else __delay_us(50);
+        n ++;
+    }
+    n = 0;
+    while (n < lcdDisplays)
+    {
+        lcdHead [n] = 0;            // All the queues start empty
+        lcdTail [n] = 0;
+        lcdCol [n] = 0;             // and all the cursors are at home
+        lcdRow [n] = 0;
+        lcdBusy [n] = 0;
+        n ++;
+    }
+    lcdBytesSent = 0;
+}
+
+void lcdMultiService ()             // Sends the next byte to every LCD that is ready for it. Call it as often as possible
+{
+    unsigned char display, tail, info;
+    display = 0;
+    while (display < lcdDisplays)
+    {
+        if (lcdBusy [display] && lcdMultiNow () - lcdSentAt [display] >= lcdWait [display]) lcdBusy [display] = 0;
+        tail = lcdTail [display];
+        if (tail != lcdHead [display] && !lcdBusy [display])
+        {
+            info = lcdQueue [display][tail];
+            lcdMultiSend (1 << display, info, lcdQueueRs [display][tail]);
+            lcdSentAt [display] = lcdMultiNow ();
+            if (lcdQueueRs [display][tail] == 0x00 && info < 0x04) lcdWait [display] = lcdLongTicks;   // Clear and home are slow
+            else lcdWait [display] = lcdShortTicks;
+            lcdBusy [display] = 1;
+            tail ++;
+            if (tail == lcdQueueSize) tail = 0;
+            lcdTail [display] = tail;
+            lcdBytesSent ++;
+        }
+        display ++;
+    }
+}
+
+unsigned char lcdMultiBusy ()       // Returns 1 while any LCD still has bytes waiting in its queue
+{
+    unsigned char display;
+    display = 0;
+    while (display < lcdDisplays)
+    {
+        if (lcdHead [display] != lcdTail [display]) return 1;
+        display ++;
+    }
+    return 0;
+}
+
+void lcdMultiPut (unsigned char display, unsigned char info, unsigned char rs)  // Puts one byte in the queue for an LCD
+{
+    unsigned char head;
+    head = lcdHead [display] + 1;
+    if (head == lcdQueueSize) head = 0;
+    while (head == lcdTail [display]) lcdMultiService ();  // The queue is full so send some bytes until there is room
+    lcdQueue [display][lcdHead [display]] = info;
+    lcdQueueRs [display][lcdHead [display]] = rs;
+    lcdHead [display] = head;
+}
+
+void lcdMultiGoto (unsigned char display, unsigned char col, unsigned char row)  // Moves the cursor of one LCD
+{
+    if (row >= lcdRows) row = lcdRows - 1;      // Off the LCD goes to the nearest character on it, as lcdGotoXY
+    if (col >= lcdColumns) col = lcdColumns - 1;
+    lcdCol [display] = col;
+    lcdRow [display] = row;
+    lcdMultiPut (display, 0x80 | (lcdRowStart [row] + col), 0x00);
+}
+
+void lcdMultiClear (unsigned char display)  // Clears one LCD and sends its cursor home
+{
+    lcdCol [display] = 0;
+    lcdRow [display] = 0;
+    lcdMultiPut (display, clearScreen, 0x00);
+}
+
+void lcdMultiWriteString (unsigned char display, const char *words)  // Writes a string at the cursor of one LCD
+{
+    while (*words)
+    {
+        lcdMultiPut (display, *words, 0x10);
+        lcdCol [display] ++;
+        words ++;
+    }
+}
+
+#endif
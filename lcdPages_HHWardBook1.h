@@ -0,0 +1,90 @@
+/*
+ * File:   lcdPages_HHWardBook1.h
+ * Name: Two pages of LCD screen with instant switching between them
+ *
+ * Each line of the LCD has 40 characters of DDRAM but only 16 can be seen. Page 0 is
+ * columns 0 to 15 of both lines and page 1 is columns 16 to 31, which cannot be seen
+ * while page 0 is showing. The next screen is written into the page that is hidden, so
+ * nobody sees the characters being changed one at a time, and then pageShow () moves
+ * the display window onto it:
+ *
+ *      page 1 to page 0    returnHome puts the display shift back to 0     1 instruction
+ *      page 0 to page 1    16 x displayLeft with lcdOutQuick               about 1ms
+ *
+ * 1ms is far quicker than the liquid crystal can change (tens of ms) so both switches
+ * look instant. Writing a whole page with lcdOutQuick takes about 2ms, compared to
+ * nearly 200ms with lcdOut.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef LCDPAGES_HHWARDBOOK1_H
+#define LCDPAGES_HHWARDBOOK1_H
+
+#include "lcd4Bit_HHWardBook1.h"
+
+#define pageWidth   16              // Characters across one page
+#define hiddenPage  (visiblePage ^ 1)   // The page that cannot be seen at the moment
+
+// Some variables
+unsigned char visiblePage;          // The page that is on the display, 0 or 1
+
+// The subroutines
+
+void pagesSetUp ()                  // Puts the display shift back to 0 so page 0 is showing
+{
+    rsLine = 0x00;
+    lcdData = returnHome;
+    lcdOut ();                      // returnHome takes 1.52ms so it goes through lcdOut
+    rsLine = 0x10;
+    visiblePage = 0;
+}
+
+void pageWriteLine (unsigned char page, unsigned char row, const char *words)  // Writes one line of a page, padded with spaces
+{
+    unsigned char n;
+    profileEnter (probePageWrite);
+    rsLine = 0x00;
+    lcdData = (row ? lineTwo : 0x80) + (page ? pageWidth : 0);  // DDRAM address of the first column of the page
+    lcdOutQuick ();
+    rsLine = 0x10;
+    n = 0;
+    while (n < pageWidth)           // Always writes all 16 columns so nothing is left over from the last screen
+    {
+        if (*words)
+        {
+            lcdData = *words;
+            words ++;
+        }
+        else lcdData = ' ';
+        lcdOutQuick ();
+        n ++;
+    }
+    profileExit (probePageWrite);
+}
+
+void pageShow (unsigned char page)  // Moves the display window onto a page
+{
+    unsigned char n;
+    if (page == visiblePage) return;
+    rsLine = 0x00;
+    if (page == 0)
+    {
+        lcdData = returnHome;       // One instruction takes the display shift from 16 back to 0
+        lcdOut ();
+    }
+    else
+    {
+        n = 0;
+        while (n < pageWidth)       // Shift the window 16 places to the left
+        {
+            lcdData = displayLeft;
+            lcdOutQuick ();
+            n ++;
+        }
+    }
+    rsLine = 0x10;
+    visiblePage = page;
+}
+
+#endif
@@ -0,0 +1,90 @@
+/*
+ * File:   pins_HHWardBook1.h
+ * Name: Pin definitions that write through the LAT registers
+ *
+ * The programs in the book write their outputs straight to PORTx (eBit, rspin, RSpin,
+ * the lamp bits and lcdPort). On the PIC18 a write to a PORT bit is really a
+ * read-modify-write: BSF PORTB,5 reads the PINS of PORTB, changes bit 5 and writes
+ * all 8 bits back to the latch. If another output pin has not reached its level yet
+ * (a capacitive load, or a pin being pulled by the LCD) the wrong value is written
+ * back to it. Writing to LATx instead reads and writes the output latch itself so
+ * the other pins can never be corrupted.
+ *
+ * A pin is described by its port letter and bit number, a group of pins by its port
+ * letter and a mask. Everything is a macro so there is no subroutine call and no
+ * RAM used, the compiler sees exactly the same instruction it would for PORTxbits.
+ *
+ *      #define lcdE     B,5            // E pin of the LCD is on RB5
+ *      #define lcdBus   B,0x3F         // RB0 to RB5 are used by the LCD
+ *      pinHigh (lcdE);                 // Compiles to BSF LATB,5
+ *      portWriteMasked (lcdBus, lcdData);  // Changes RB0 to RB5 in one write, RB6 and RB7 untouched
+ *
+ * Instruction count, XC8 on the PIC18F4525 (LATx and PORTx are both in the access bank
+ * so there is never a BANKSEL):
+ *
+ *      Operation                       Before (PORTx)              After (LATx)
+ *      eBit = 1; eBit = 0;             BSF/BCF PORTB,5   2 words   BSF/BCF LATB,5    2 words
+ *      RSpin = 0;                      BCF PORTA,1       1 word    BCF LATA,1        1 word
+ *      lcdPort = lcdData;              MOVFF             2 words   MOVFF             2 words
+ *      PORTB = ADRESH;                 MOVFF             2 words   MOVFF             2 words
+ *      redLamp1 = 0; amberLamp1 = 0;   BCF,BCF,BSF       3 words   BCF,BCF,BSF       3 words
+ *          greenLamp1 = 1;
+ *      5 bits changed, 3 kept          BCF/BSF x 5      10 words   portWriteMasked   4 words
+ *
+ * So every existing bit and port write stays the same size and anything that changes
+ * more than 3 bits of a port together gets smaller with portWriteMasked. It is built as
+ * MOVF LATx,W / XORWF value,W / ANDLW mask / XORWF LATx,F so all the pins in the mask
+ * change on the same instruction cycle. Note: it is only a single write, it is not
+ * protected from an interrupt that changes other bits of the same LAT register between
+ * the MOVF and the XORWF.
+ *
+ * Host simulator: define PIN_HOST_BACKEND before including this file and every write
+ * becomes a call to hostPinWrite (port, mask, value) and every read a call to
+ * hostPinRead (port). The host program provides those two subroutines, host/pinsVcd.c
+ * has a pair that records every pin change into a VCD file for GTKWave.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef PINS_HHWARDBOOK1_H
+#define PINS_HHWARDBOOK1_H
+
+// The public macros take a descriptor such as "B,5" and pass it on to the real macro.
+// The extra step is needed so the descriptor is split into its port and bit before use.
+
+#define pinHigh(pin)                pinHigh_(pin)
+#define pinLow(pin)                 pinLow_(pin)
+#define pinWrite(pin, value)        pinWrite_(pin, value)
+#define pinRead(pin)                pinRead_(pin)
+#define portWrite(port, value)      portWrite_(port, value)
+#define portWriteMasked(group, value)   portWriteMasked_(group, value)
+#define portRead(port)              portRead_(port)
+
+#ifndef PIN_HOST_BACKEND
+
+#include "simTime_HHWardBook1.h"    // Only does anything when SIM_FAST_FORWARD is defined
+
+#define pinHigh_(port, bit)         (LAT##port##bits.LAT##port##bit = 1)        // BSF LATx,bit
+#define pinLow_(port, bit)          (LAT##port##bits.LAT##port##bit = 0)        // BCF LATx,bit
+#define pinWrite_(port, bit, value) (LAT##port##bits.LAT##port##bit = (value))  // BTFSC/BSF/BTFSS/BCF
+#define pinRead_(port, bit)         (PORT##port##bits.R##port##bit)             // Inputs are still read from the PORT
+#define portWrite_(port, value)     (LAT##port = (value))                       // MOVFF or MOVWF
+#define portWriteMasked_(port, mask, value) (LAT##port ^= (LAT##port ^ (value)) & (mask))
+#define portRead_(port)             (PORT##port)
+
+#else
+
+extern void hostPinWrite (char port, unsigned char mask, unsigned char value);   // Supplied by the host program
+extern unsigned char hostPinRead (char port);
+
+#define pinHigh_(port, bit)         hostPinWrite (#port[0], 1 << (bit), 0xFF)
+#define pinLow_(port, bit)          hostPinWrite (#port[0], 1 << (bit), 0x00)
+#define pinWrite_(port, bit, value) hostPinWrite (#port[0], 1 << (bit), (value) ? 0xFF : 0x00)
+#define pinRead_(port, bit)         ((hostPinRead (#port[0]) >> (bit)) & 1)
+#define portWrite_(port, value)     hostPinWrite (#port[0], 0xFF, (value))
+#define portWriteMasked_(port, mask, value) hostPinWrite (#port[0], (mask), (value))
+#define portRead_(port)             hostPinRead (#port[0])
+
+#endif
+
+#endif
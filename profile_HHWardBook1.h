@@ -0,0 +1,139 @@
+/*
+ * File:   profile_HHWardBook1.h
+ * Name: Measuring how long subroutines take using Timer 1
+ *
+ * Put profileEnter (id) at the start of a piece of code and profileExit (id) at the end.
+ * Timer 1 counts every instruction cycle (0.5us at 8MHz) and the interrupt counts its
+ * overflows, so times from 1 cycle up to over half an hour can be measured. For each
+ * probe id the table keeps the number of calls, the total cycles and the shortest and
+ * longest call. The time the probes themselves take is measured in profileSetUp, the
+ * shortest of profileCalibrations empty probes, and taken off every reading. A reading
+ * shorter than that counts as 0.
+ *
+ * Profiling is only compiled in when PROFILE is defined (e.g. -DPROFILE or in the
+ * project properties). Without it profileEnter and profileExit are empty so the probes
+ * cost nothing and the table takes no RAM.
+ *
+ * The program must call profileSetUp () once and profileInterrupt () from its interrupt
+ * routine. profileText () gives the results for one probe as two short lines that
+ * can go to the LCD with writeString or out of the EUSART with printf.
+ *
+ * Note: a probe inside another is counted in the outer time as well, and the same id
+ * must not be entered again before it has exited.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef PROFILE_HHWARDBOOK1_H
+#define PROFILE_HHWARDBOOK1_H
+
+// The probe ids used by the shared subroutines, programs can use the rest
+#define probeSendData       0
+#define probeLcdOut         1
+#define probeWriteString    2
+#define probeSystemVoltage  3
+#define probeSprintf        4
+#define probePageWrite      5
+#define profileProbes       8       // Size of the table
+#define profileCalibrations 8       // Empty probes timed in profileSetUp, the shortest is the overhead
+
+#ifdef PROFILE
+
+#include <stdio.h>
+
+#define profileEnter(id)    (profileStart [id] = profileNow ())
+#define profileExit(id)     profileAdd (id, profileNow () - profileStart [id])
+
+// Some variables
+volatile unsigned int profileOverflows;     // Timer 1 overflows, the top 16 bits of the time
+unsigned long profileStart [profileProbes]; // Time each probe was entered
+unsigned int profileCount [profileProbes];  // Number of calls
+unsigned long profileTotal [profileProbes]; // Total cycles
+unsigned long profileMin [profileProbes], profileMax [profileProbes];   // Shortest and longest call
+unsigned long profileOverhead;              // Cycles the probes add to every reading
+
+// The subroutines
+
+unsigned long profileNow ()         // 32-bit count of instruction cycles
+{
+    unsigned int high, wraps;
+    unsigned char low, timerHigh;
+    do
+    {
+        high = profileOverflows;
+        low = TMR1L;                // Reading TMR1L copies the high byte into TMR1H (RD16)
+        timerHigh = TMR1H;
+        wraps = high;
+        if (PIR1bits.TMR1IF && !(timerHigh & 0x80)) wraps ++;  // Just wrapped and the interrupt has not counted it yet,
+    }                                                       // e.g. called with interrupts off or from the interrupt routine
+    while (high != profileOverflows);   // Timer 1 overflowed while it was being read, read it again
+    return ((unsigned long) wraps << 16) | ((unsigned int) timerHigh << 8) | low;
+}
+
+void profileAdd (unsigned char id, unsigned long cycles)   // Adds one call to the table
+{
+    cycles = cycles > profileOverhead ? cycles - profileOverhead : 0;   // An interrupt in the calibration must not make it go round
+    profileCount [id] ++;
+    profileTotal [id] += cycles;
+    if (profileCount [id] == 1 || cycles < profileMin [id]) profileMin [id] = cycles;
+    if (cycles > profileMax [id]) profileMax [id] = cycles;
+}
+
+void profileClear ()                // Empties the table
+{
+    unsigned char id;
+    id = 0;
+    while (id < profileProbes)
+    {
+        profileCount [id] = 0;
+        profileTotal [id] = 0;
+        profileMin [id] = 0;
+        profileMax [id] = 0;
+        id ++;
+    }
+}
+
+void profileSetUp ()
+{
+    T1CON = 0b10000001;             // RD16 = 1, 1:1 prescale, internal clock, Timer 1 on so it counts instruction cycles
+    profileOverflows = 0;
+    PIR1bits.TMR1IF = 0;
+    PIE1bits.TMR1IE = 1;            // Count the overflows
+    INTCONbits.PEIE = 1;
+    INTCONbits.GIE = 1;
+    profileOverhead = 0;
+    profileClear ();
+    while (profileCount [0] < profileCalibrations)
+    {
+        profileEnter (0);           // An empty probe gives the overhead
+        profileExit (0);
+    }
+    profileOverhead = profileMin [0];   // The shortest, one with an interrupt in it is longer
+    profileClear ();
+}
+
+void profileInterrupt ()            // Call this from the interrupt routine
+{
+    if (PIE1bits.TMR1IE && PIR1bits.TMR1IF)
+    {
+        PIR1bits.TMR1IF = 0;
+        profileOverflows ++;
+    }
+}
+
+void profileText (unsigned char id, char *line1, char *line2)  // Results for one probe, each line can be up to 21 characters
+{
+    unsigned long average;
+    average = profileCount [id] ? profileTotal [id] / profileCount [id] : 0;
+    sprintf (line1, "P%u n%u a%lu", id, profileCount [id], average);
+    sprintf (line2, "%lu-%lu", profileMin [id], profileMax [id]);
+}
+
+#else
+
+#define profileEnter(id)
+#define profileExit(id)
+
+#endif
+
+#endif
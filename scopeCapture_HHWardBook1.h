@@ -0,0 +1,129 @@
+/*
+ * File:   scopeCapture_HHWardBook1.h
+ * Name: Triggered burst capture of the ADC ("scope" mode)
+ *
+ * CCP2 is used in compare mode with the special event trigger. Every time Timer 3
+ * reaches CCPR2 it is reset and the ADC starts a conversion by itself, so the samples
+ * are exactly evenly spaced and the program does not have to start each one. The ADC
+ * interrupt stores the result in a circular buffer, packed 4 samples to 5 bytes in the
+ * same way as telemetry_HHWardBook1.h (4 x ADRESH then a byte of the bottom 2 bits).
+ *
+ * The trigger is a level and an edge, checked against the top 8 bits of each sample.
+ * Before the trigger the buffer keeps going round so it always holds the most recent
+ * samples. Once the trigger is seen only enough samples are taken to fill the part of
+ * the buffer after the pre-trigger percentage, then the capture stops and freezes.
+ *
+ * Speed, at 8MHz (Tcy = 0.5us, TAD = 1us with FOSC/8):
+ *
+ *      acquisition 2 TAD + conversion 11 TAD       13us    26 Tcy
+ *      ADC interrupt including saving registers    about 45 Tcy
+ *      shortest safe sample period                 50 Tcy (CCPR2 = 50) = 25us
+ *
+ * so the maximum sustained rate is 40000 samples a second. With the 2000 byte buffer the
+ * capture depth is 1600 samples, which is 40ms at that rate.
+ *
+ * The program's interrupt routine must call scopeInterrupt ().
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef SCOPECAPTURE_HHWARDBOOK1_H
+#define SCOPECAPTURE_HHWARDBOOK1_H
+
+#define scopeBytes      2000        // Size of the capture buffer, must be a multiple of 5
+#define scopeDepth      (scopeBytes / 5 * 4)    // Number of samples it holds, 1600
+#define risingEdge      0
+#define fallingEdge     1
+#define scopeArmed      1           // Values of scopeState
+#define scopeTriggered  2
+#define scopeFrozen     3
+
+// Some variables
+unsigned char scopeBuffer [scopeBytes];     // The packed samples
+volatile unsigned char scopeState;          // 0 = off, then armed, triggered and frozen
+unsigned int scopeGroup;                    // Where the next group of 4 samples starts in scopeBuffer
+unsigned char scopeSlot, scopeLow;          // Which of the 4 samples is next and the bottom bits collected so far
+unsigned char scopeLevel, scopeEdge, scopeLast; // The trigger and the top 8 bits of the last sample
+unsigned int scopeFilled;                   // Samples taken since arming, stops counting at the pre-trigger amount
+unsigned int scopePre, scopeLeft;           // Samples wanted before the trigger and samples still to take after it
+unsigned int scopeAfter;                    // Samples taken after the trigger
+unsigned int scopeStart;                    // Group where the oldest sample is once frozen
+unsigned int scopeTrigger;                  // Index of the trigger sample once frozen
+
+// The subroutines
+
+void scopeArm (unsigned char level, unsigned char edge, unsigned char prePercent, unsigned int period)
+{                                           // Starts a capture, period is in Tcy (0.5us) and must be 50 or more
+    PIE1bits.ADIE = 0;
+    CCP2CON = 0x00;                         // Stop any capture that is going
+    scopeGroup = 0;
+    scopeSlot = 0;
+    scopeFilled = 0;
+    scopeAfter = 0;
+    scopeLevel = level;
+    scopeEdge = edge;
+    scopeLast = edge == risingEdge ? 0xFF : 0x00;   // So the first sample cannot look like an edge
+    scopePre = (unsigned long) scopeDepth * prePercent / 100;
+    scopeLeft = scopeDepth - scopePre;
+    ADCON2 = 0b00001001;                    // Left justify, 2 TAD acquisition, FOSC/8 so TAD = 1us
+    T3CON = 0b10001001;                     // RD16, 1:1, Timer 3 for CCP2 and Timer 1 for CCP1, on
+    TMR3H = 0;
+    TMR3L = 0;
+    CCPR2H = period >> 8;
+    CCPR2L = period & 0xFF;
+    scopeState = scopeArmed;
+    PIR1bits.ADIF = 0;
+    PIE1bits.ADIE = 1;
+    INTCONbits.PEIE = 1;
+    INTCONbits.GIE = 1;
+    CCP2CON = 0b00001011;                   // Compare mode with special event trigger, this starts the sampling
+}
+
+void scopeInterrupt ()                      // Call this from the interrupt routine. Kept as short as possible
+{
+    unsigned char high;
+    if (!PIR1bits.ADIF) return;
+    PIR1bits.ADIF = 0;
+    high = ADRESH;
+    scopeBuffer [scopeGroup + scopeSlot] = high;
+    scopeLow = (scopeLow << 2) | (ADRESL >> 6);
+    if (scopeState == scopeArmed)
+    {
+        if (scopeFilled < scopePre) scopeFilled ++;     // Not enough samples before the trigger yet
+        else if (scopeEdge == risingEdge ? (scopeLast < scopeLevel && high >= scopeLevel)
+                                         : (scopeLast > scopeLevel && high <= scopeLevel))
+            scopeState = scopeTriggered;
+        scopeLast = high;
+    }
+    else
+    {
+        scopeAfter ++;
+        if (scopeLeft) scopeLeft --;
+    }
+    scopeSlot ++;
+    if (scopeSlot < 4) return;
+    scopeBuffer [scopeGroup + 4] = scopeLow;   // Group of 4 complete, store the bottom bits
+    scopeSlot = 0;
+    scopeGroup += 5;
+    if (scopeGroup == scopeBytes) scopeGroup = 0;
+    if (scopeState == scopeTriggered && !scopeLeft)   // Enough after the trigger, stop on a whole group
+    {
+        CCP2CON = 0x00;
+        PIE1bits.ADIE = 0;
+        scopeStart = scopeGroup;            // The next group to be written would have been the oldest
+        scopeTrigger = scopeDepth - 1 - scopeAfter;
+        scopeState = scopeFrozen;
+    }
+}
+
+unsigned int scopeSample (unsigned int index)   // 10-bit sample number index of a frozen capture, 0 is the oldest
+{
+    unsigned int group;
+    unsigned char slot;
+    group = scopeStart + (index / 4) * 5;
+    if (group >= scopeBytes) group -= scopeBytes;
+    slot = index & 0x03;
+    return ((unsigned int) scopeBuffer [group + slot] << 2) | ((scopeBuffer [group + 4] >> (6 - 2 * slot)) & 0x03);
+}
+
+#endif
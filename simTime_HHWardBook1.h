@@ -0,0 +1,143 @@
+/*
+ * File:   simTime_HHWardBook1.h
+ * Name: Skipping the delays when running in the MPLAB X simulator
+ *
+ * The simulator runs __delay_ms one instruction at a time, so one 5 second traffic light
+ * phase is 2.5 million instruction cycles and a run of the LCD programs is mostly spent
+ * in the 3ms waits. With SIM_FAST_FORWARD defined __delay_ms and __delay_us do not wait,
+ * they jump the time on instead:
+ *
+ *      simCycles and simWraps      the instruction cycles skipped so far, a 48-bit count,
+ *                                  watch them to see the time the program thinks has passed
+ *      Timer 1                     moved on by the skipped cycles, 10ms at a time so each
+ *                                  overflow still sets TMR1IF and the interrupt counts it
+ *                                  (the profiler, the trace and lcdMulti use Timer 1)
+ *      Timer 0                     the same, through its prescaler in 8 or 16-bit mode,
+ *                                  setting TMR0IF (VoltMeter's boot time, the marquee and
+ *                                  the book's programs that poll TMR0IF)
+ *      Timer 3                     the same, setting TMR3IF (the scope's CCP2)
+ *
+ * Only timers running from the instruction clock are moved. Timer 2 is left behind, and so
+ * is a timer counting an external clock. In 8-bit mode Timer 0 overflows every 256
+ * prescaled ticks, so with a prescale under 1:128 one 10ms step can hold more than one
+ * overflow and TMR0IF is only set once for them.
+ *
+ * Each 10ms (20000 cycles) skipped now moves three timers on, which counted from the C is
+ * about 80 instructions a timer that is on and 10 for one that is off, so roughly 250 for
+ * the three when they are all running, and under 100 for a program that only uses Timer 1.
+ * Time it with the MPLAB X stopwatch to be sure. Either way the simulator gets through
+ * about a hundred times more of the program's time per second. Only for the simulator:
+ * with the delays gone a real LCD would not keep up.
+ *
+ * Not done: saving and going back to a snapshot of the machine, for example to run the
+ * slow start up once and then try many inputs from that point. A program cannot save its
+ * own program counter, return stack and SFRs from C, and the MPLAB X simulator has no
+ * command to do it that a program can call. The nearest is to make the start up fast with
+ * SIM_FAST_FORWARD and run it again each time, or to stop at a breakpoint after it and
+ * change the inputs by hand or with a stimulus file (see adcStimulus.c).
+ *
+ * Included by pins_HHWardBook1.h, so every program that uses it gets it. Not used with
+ * PIN_HOST_BACKEND, the PC build moves its own time on (see host/pinsVcd.h).
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef SIMTIME_HHWARDBOOK1_H
+#define SIMTIME_HHWARDBOOK1_H
+
+#ifdef SIM_FAST_FORWARD
+
+#define simStep     20000           // Cycles moved on at a time, 10ms, less than one Timer 1 or Timer 3 overflow
+
+// Some variables
+unsigned long simCycles;            // Cycles skipped, bottom 32 bits
+unsigned int simWraps;              // Times simCycles has gone past 0xFFFFFFFF
+unsigned char simRest0, simRest1, simRest3; // Cycles left in each prescaler that have not made a tick yet
+
+// The subroutines
+
+unsigned int simTicks (unsigned int cycles, unsigned char shift, unsigned char *rest)  // Cycles through a 1:2^shift prescaler
+{
+    unsigned int ticks;
+    cycles += *rest;
+    ticks = cycles >> shift;
+    *rest = cycles - (ticks << shift);
+    return ticks;
+}
+
+void simTimer0 (unsigned int cycles)    // Moves Timer 0 on as if cycles had passed
+{
+    unsigned char low;
+    unsigned int timer;
+    if (!T0CONbits.TMR0ON || T0CONbits.T0CS) return;   // Off or counting T0CKI
+    cycles = simTicks (cycles, T0CONbits.PSA ? 0 : T0CONbits.T0PS + 1, &simRest0);     // No prescaler or 1:2 to 1:256
+    low = TMR0L;                    // Reading TMR0L copies the high byte into TMR0H
+    if (T0CONbits.T08BIT)
+    {
+        timer = low + cycles;
+        TMR0L = timer & 0xFF;
+        if (timer > 0xFF) INTCONbits.TMR0IF = 1;
+        return;
+    }
+    timer = ((unsigned int) TMR0H << 8) | low;
+    timer += cycles;
+    TMR0H = timer >> 8;             // The high byte is written when TMR0L is written
+    TMR0L = timer & 0xFF;
+    if (timer < cycles) INTCONbits.TMR0IF = 1;
+}
+
+void simTimer1 (unsigned int cycles)    // Moves Timer 1 on as if cycles had passed
+{
+    unsigned char low;
+    unsigned int timer;
+    if (!T1CONbits.TMR1ON || T1CONbits.TMR1CS) return;
+    low = TMR1L;                    // Reading TMR1L copies the high byte into TMR1H (RD16)
+    timer = ((unsigned int) TMR1H << 8) | low;
+    cycles = simTicks (cycles, T1CONbits.T1CKPS, &simRest1);    // 1:1, 1:2, 1:4 or 1:8 prescale
+    timer += cycles;
+    TMR1H = timer >> 8;             // With RD16 the high byte is written when TMR1L is written
+    TMR1L = timer & 0xFF;
+    if (timer < cycles) PIR1bits.TMR1IF = 1;    // It went past 0xFFFF, the interrupt runs now if it is on
+}
+
+void simTimer3 (unsigned int cycles)    // Moves Timer 3 on as if cycles had passed
+{
+    unsigned char low;
+    unsigned int timer;
+    if (!T3CONbits.TMR3ON || T3CONbits.TMR3CS) return;
+    low = TMR3L;                    // Reading TMR3L copies the high byte into TMR3H (RD16)
+    timer = ((unsigned int) TMR3H << 8) | low;
+    cycles = simTicks (cycles, T3CONbits.T3CKPS, &simRest3);
+    timer += cycles;
+    TMR3H = timer >> 8;
+    TMR3L = timer & 0xFF;
+    if (timer < cycles) PIR2bits.TMR3IF = 1;
+}
+
+void simTimers (unsigned int cycles)
+{
+    simTimer0 (cycles);
+    simTimer1 (cycles);
+    simTimer3 (cycles);
+}
+
+void simSkip (unsigned long cycles) // Used instead of waiting
+{
+    simCycles += cycles;
+    if (simCycles < cycles) simWraps ++;
+    while (cycles > simStep)
+    {
+        simTimers (simStep);
+        cycles -= simStep;
+    }
+    simTimers (cycles);
+}
+
+#undef __delay_ms
+#undef __delay_us
+#define __delay_ms(x)   simSkip ((unsigned long) (x) * (_XTAL_FREQ / 4000))
+#define __delay_us(x)   simSkip ((unsigned long) (x) * (_XTAL_FREQ / 4000000))
+
+#endif
+
+#endif
@@ -0,0 +1,151 @@
+/*
+ * File:   telemetry_HHWardBook1.h
+ * Name: Sending ADC samples out of the EUSART in binary frames
+ *
+ * The samples are put into frames and the frames into a ring buffer in RAM. The EUSART
+ * transmit interrupt takes the bytes out of the ring buffer and loads them into TXREG
+ * one at a time, so the program only spends time putting the frame together.
+ *
+ * Each frame is:
+ *
+ *      0xA5            start of frame
+ *      sequence        goes up by one every frame, so the PC can see if any are lost
+ *      channel         the ADC channel the samples came from
+ *      count           number of samples, always a multiple of 4
+ *      data            count / 4 groups of 5 bytes, see below
+ *      crc             CRC-8 (polynomial 0x07) of everything from sequence to the end of data
+ *
+ * The 10-bit samples are packed 4 into 5 bytes. The first 4 bytes are the top 8 bits of
+ * each sample (what is in ADRESH when the ADC is left justified) and the fifth byte is the
+ * bottom 2 bits of each (bits 7:6 of ADRESL), sample 0 in bits 7:6 down to sample 3 in
+ * bits 1:0. That is 1.25 bytes a sample instead of 2.
+ *
+ * The baud rate is set by telemetryBaud (SPBRG value with BRG16 = 1, BRGH = 1). A frame
+ * of 16 samples is 25 bytes, 20 of data and 5 of start, sequence, channel, count and CRC,
+ * and each byte takes 10 bits on the line:
+ *
+ *      SPBRG   Baud at 8MHz    Frames/s    Samples/s (16 a frame)  CPU used by the interrupt
+ *      7       250000          1000        16000                   about 30%
+ *      3       500000          2000        32000                   about 60%
+ *
+ * If there is not enough room in the ring buffer for a whole frame, the frame is dropped
+ * and telemetryDropped goes up. The sequence number still goes up so the PC sees the gap.
+ *
+ * The program's interrupt routine must call telemetryInterrupt (). TX is on RC6.
+ * host/telemetryDecode.c decodes the frames on the PC.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef TELEMETRY_HHWARDBOOK1_H
+#define TELEMETRY_HHWARDBOOK1_H
+
+#ifndef telemetryBaud
+#define telemetryBaud   7           // 250000 baud at 8MHz
+#endif
+#define telemetrySize   128         // Bytes in the ring buffer, must be a power of 2
+#define frameStart      0xA5
+
+const unsigned char crcTable [256] =    // CRC-8 (x^8 + x^2 + x + 1) of every byte value, kept in program memory
+{
+    0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15, 0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D,
+    0x70, 0x77, 0x7E, 0x79, 0x6C, 0x6B, 0x62, 0x65, 0x48, 0x4F, 0x46, 0x41, 0x54, 0x53, 0x5A, 0x5D,
+    0xE0, 0xE7, 0xEE, 0xE9, 0xFC, 0xFB, 0xF2, 0xF5, 0xD8, 0xDF, 0xD6, 0xD1, 0xC4, 0xC3, 0xCA, 0xCD,
+    0x90, 0x97, 0x9E, 0x99, 0x8C, 0x8B, 0x82, 0x85, 0xA8, 0xAF, 0xA6, 0xA1, 0xB4, 0xB3, 0xBA, 0xBD,
+    0xC7, 0xC0, 0xC9, 0xCE, 0xDB, 0xDC, 0xD5, 0xD2, 0xFF, 0xF8, 0xF1, 0xF6, 0xE3, 0xE4, 0xED, 0xEA,
+    0xB7, 0xB0, 0xB9, 0xBE, 0xAB, 0xAC, 0xA5, 0xA2, 0x8F, 0x88, 0x81, 0x86, 0x93, 0x94, 0x9D, 0x9A,
+    0x27, 0x20, 0x29, 0x2E, 0x3B, 0x3C, 0x35, 0x32, 0x1F, 0x18, 0x11, 0x16, 0x03, 0x04, 0x0D, 0x0A,
+    0x57, 0x50, 0x59, 0x5E, 0x4B, 0x4C, 0x45, 0x42, 0x6F, 0x68, 0x61, 0x66, 0x73, 0x74, 0x7D, 0x7A,
+    0x89, 0x8E, 0x87, 0x80, 0x95, 0x92, 0x9B, 0x9C, 0xB1, 0xB6, 0xBF, 0xB8, 0xAD, 0xAA, 0xA3, 0xA4,
+    0xF9, 0xFE, 0xF7, 0xF0, 0xE5, 0xE2, 0xEB, 0xEC, 0xC1, 0xC6, 0xCF, 0xC8, 0xDD, 0xDA, 0xD3, 0xD4,
+    0x69, 0x6E, 0x67, 0x60, 0x75, 0x72, 0x7B, 0x7C, 0x51, 0x56, 0x5F, 0x58, 0x4D, 0x4A, 0x43, 0x44,
+    0x19, 0x1E, 0x17, 0x10, 0x05, 0x02, 0x0B, 0x0C, 0x21, 0x26, 0x2F, 0x28, 0x3D, 0x3A, 0x33, 0x34,
+    0x4E, 0x49, 0x40, 0x47, 0x52, 0x55, 0x5C, 0x5B, 0x76, 0x71, 0x78, 0x7F, 0x6A, 0x6D, 0x64, 0x63,
+    0x3E, 0x39, 0x30, 0x37, 0x22, 0x25, 0x2C, 0x2B, 0x06, 0x01, 0x08, 0x0F, 0x1A, 0x1D, 0x14, 0x13,
+    0xAE, 0xA9, 0xA0, 0xA7, 0xB2, 0xB5, 0xBC, 0xBB, 0x96, 0x91, 0x98, 0x9F, 0x8A, 0x8D, 0x84, 0x83,
+    0xDE, 0xD9, 0xD0, 0xD7, 0xC2, 0xC5, 0xCC, 0xCB, 0xE6, 0xE1, 0xE8, 0xEF, 0xFA, 0xFD, 0xF4, 0xF3,
+};
+
+// Some variables
+unsigned char telemetryBuffer [telemetrySize];      // The ring buffer of bytes waiting to be sent
+volatile unsigned char telemetryHead, telemetryTail; // Where the next byte goes in and where the interrupt takes the next one out
+unsigned char telemetrySequence;                    // Sequence number of the next frame
+unsigned int telemetryDropped;                      // Frames that did not fit in the ring buffer
+unsigned char telemetryCrc;
+
+// The subroutines
+
+void telemetrySetUp ()              // Sets the EUSART up to transmit
+{
+    TRISCbits.TRISC6 = 0;           // TX is an output
+    BAUDCON = 0b00001000;           // BRG16 = 1, 16-bit baud rate generator
+    SPBRGH = 0;
+    SPBRG = telemetryBaud;          // Baud = FOSC / (4 x (SPBRG + 1))
+    TXSTA = 0b00100100;             // TXEN = 1 transmit on, BRGH = 1 high speed, asynchronous
+    RCSTA = 0b10000000;             // SPEN = 1 turns the serial port on
+    telemetryHead = 0;
+    telemetryTail = 0;
+    PIE1bits.TXIE = 0;              // Only turned on when there is something to send
+    INTCONbits.PEIE = 1;            // The EUSART is a peripheral interrupt
+    INTCONbits.GIE = 1;
+}
+
+void telemetryInterrupt ()          // Call this from the interrupt routine
+{
+    if (PIE1bits.TXIE && PIR1bits.TXIF)     // TXREG is empty and there is something to send
+    {
+        TXREG = telemetryBuffer [telemetryTail];
+        telemetryTail = (telemetryTail + 1) & (telemetrySize - 1);
+        if (telemetryTail == telemetryHead) PIE1bits.TXIE = 0;   // Nothing left so stop the interrupts
+    }
+}
+
+void telemetryAdd (unsigned char info)  // Puts one byte of the frame in the ring buffer and adds it to the CRC
+{
+    telemetryBuffer [telemetryHead] = info;
+    telemetryHead = (telemetryHead + 1) & (telemetrySize - 1);
+    telemetryCrc = crcTable [telemetryCrc ^ info];  // One table read instead of working through the 8 bits
+}
+
+unsigned char telemetryRoom ()      // How many bytes can be put in the ring buffer at the moment
+{
+    return (telemetryTail - telemetryHead - 1) & (telemetrySize - 1);  // The interrupt can only make this bigger
+}
+
+void telemetrySendFrame (unsigned char channel, const unsigned int *samples, unsigned char count)
+{                                   // Sends count 10-bit samples, count must be a multiple of 4
+    unsigned char size, low, n;
+    size = 5 + count + count / 4;   // Header, data and CRC
+    if (size > telemetryRoom ())
+    {
+        telemetryDropped ++;
+        telemetrySequence ++;
+        return;
+    }
+    telemetryBuffer [telemetryHead] = frameStart;   // The start byte is not part of the CRC
+    telemetryHead = (telemetryHead + 1) & (telemetrySize - 1);
+    telemetryCrc = 0;
+    telemetryAdd (telemetrySequence);
+    telemetryAdd (channel);
+    telemetryAdd (count);
+    while (count)
+    {
+        low = 0;
+        n = 0;
+        while (n < 4)               // The top 8 bits of 4 samples
+        {
+            telemetryAdd (samples [n] >> 2);
+            low = (low << 2) | (samples [n] & 0x03);
+            n ++;
+        }
+        telemetryAdd (low);         // and then their bottom 2 bits in one byte
+        samples += 4;
+        count -= 4;
+    }
+    telemetryBuffer [telemetryHead] = telemetryCrc;
+    telemetryHead = (telemetryHead + 1) & (telemetrySize - 1);
+    telemetrySequence ++;
+    PIE1bits.TXIE = 1;              // Start (or keep) the interrupt sending
+}
+
+#endif
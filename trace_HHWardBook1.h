@@ -0,0 +1,177 @@
+/*
+ * File:   trace_HHWardBook1.h
+ * Name: Recording timestamped events in RAM to look at later
+ *
+ * traceEvent (id, arg) stores a 4 byte record in a ring buffer in RAM:
+ *
+ *      Timer 1 low byte, Timer 1 high byte, event id, 8-bit argument
+ *
+ * Timer 1 counts instruction cycles (0.5us at 8MHz) and wraps every 32.8ms. When Timer 1
+ * has wrapped since the last record an extra traceOverflow record is stored first, with
+ * the number of wraps as its argument, so the PC can work out the full time. Gaps of up
+ * to 255 wraps (8.3 seconds) between records are timed correctly.
+ *
+ * traceEvent turns the interrupts off while it writes so it can be called from the main
+ * program and from the interrupt routine. When the buffer is full the oldest records are
+ * written over. traceFreezeOn (id, after) stops the recording 'after' records after the
+ * next event with that id, so what led up to it is kept.
+ *
+ * traceDump () sends the buffer out of the EUSART (TX on RC6): 'T', 'R', the number of
+ * records, then the records oldest first. host/traceTimeline.c turns a dump into a
+ * timeline and histograms.
+ *
+ * Tracing is only compiled in when TRACE is defined, without it traceEvent is empty.
+ * The program must call traceSetUp () once and traceInterrupt () from its interrupt
+ * routine.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef TRACE_HHWARDBOOK1_H
+#define TRACE_HHWARDBOOK1_H
+
+#include "profile_HHWardBook1.h"
+
+// The event ids
+#define traceOverflow   0           // Timer 1 wrapped, arg = number of times
+#define traceLcdCommand 1           // Instruction byte sent to the LCD, arg = the instruction
+#define traceLcdData    2           // Data byte sent to the LCD, arg = the character
+#define traceAdcDone    3           // ADC conversion finished, arg = ADRESH
+#define tracePhase      4           // Traffic light phase changed, arg = the new phase
+#define traceButton     5           // A button changed, arg = its new level
+#define traceBusWrite   6           // Something written to an output port, arg = the new value
+
+#ifdef TRACE
+
+#define traceRecords    64          // Records in the ring buffer, 256 bytes
+#define traceRunning    0           // Values of traceState
+#define traceTriggered  1
+#define traceFrozen     2
+
+// Some variables
+unsigned char traceBuffer [traceRecords][4];
+unsigned char traceNext, traceCount;    // Where the next record goes and how many there are
+unsigned char traceState, traceTriggerId, traceLeft;
+#ifdef PROFILE
+#define traceOverflows  profileOverflows    // The profiler already counts the Timer 1 overflows
+#else
+volatile unsigned int traceOverflows;       // Timer 1 overflows counted by the interrupt, 16 bits as freqMeter shares it
+#endif
+unsigned char traceLastOverflows;           // traceOverflows when the last record was stored
+
+// The subroutines
+
+void tracePut (unsigned char id, unsigned char arg, unsigned char low, unsigned char high)
+{
+    traceBuffer [traceNext][0] = low;
+    traceBuffer [traceNext][1] = high;
+    traceBuffer [traceNext][2] = id;
+    traceBuffer [traceNext][3] = arg;
+    traceNext = (traceNext + 1) & (traceRecords - 1);
+    if (traceCount < traceRecords) traceCount ++;
+}
+
+void traceEvent (unsigned char id, unsigned char arg)  // Stores one event, safe to call from the interrupt routine
+{
+    unsigned char gie, low, high, wraps;
+    gie = INTCONbits.GIE;
+    INTCONbits.GIE = 0;             // Nothing else can write a record until this one is done
+    if (traceState != traceFrozen)
+    {
+        low = TMR1L;                // Reading TMR1L copies the high byte into TMR1H (RD16)
+        high = TMR1H;
+        wraps = (unsigned char) traceOverflows - traceLastOverflows;
+        if (PIR1bits.TMR1IF && !(high & 0x80)) wraps ++;   // Just wrapped and the interrupt has not counted it yet
+        if (wraps)
+        {
+            tracePut (traceOverflow, wraps, low, high);
+            traceLastOverflows += wraps;
+        }
+        tracePut (id, arg, low, high);
+        if (traceState == traceTriggered)
+        {
+            traceLeft --;
+            if (!traceLeft) traceState = traceFrozen;
+        }
+        else if (id == traceTriggerId && traceLeft) traceState = traceTriggered;
+    }
+    INTCONbits.GIE = gie;
+}
+
+void traceFreezeOn (unsigned char id, unsigned char after)  // Freeze 'after' records after the next event 'id'
+{
+    traceTriggerId = id;
+    traceLeft = after;
+}
+
+void traceSetUp ()
+{
+    T1CON = 0b10000001;             // RD16 = 1, 1:1 prescale, internal clock, Timer 1 on so it counts instruction cycles
+    traceNext = 0;
+    traceCount = 0;
+    traceState = traceRunning;
+    traceLeft = 0;                  // No trigger until traceFreezeOn is called
+    traceLastOverflows = traceOverflows;
+    PIR1bits.TMR1IF = 0;
+    PIE1bits.TMR1IE = 1;
+    INTCONbits.PEIE = 1;
+    INTCONbits.GIE = 1;
+}
+
+void traceInterrupt ()              // Call this from the interrupt routine
+{
+#ifndef PROFILE
+    if (PIE1bits.TMR1IE && PIR1bits.TMR1IF)
+    {
+        PIR1bits.TMR1IF = 0;
+        traceOverflows ++;
+    }
+#endif
+}
+
+void traceSend (unsigned char info) // Sends one byte out of the EUSART and waits for it to go
+{
+    while (!PIR1bits.TXIF);
+    TXREG = info;
+}
+
+void traceDump ()                   // Sends the whole buffer out of the EUSART, oldest record first
+{
+    unsigned char record, n, gie;
+    gie = INTCONbits.GIE;
+    INTCONbits.GIE = 0;             // Keep the buffer still while it is sent
+    if (!RCSTAbits.SPEN)            // Set the EUSART up if the program has not, 250000 baud
+    {
+        TRISCbits.TRISC6 = 0;
+        BAUDCON = 0b00001000;
+        SPBRGH = 0;
+        SPBRG = 7;
+        TXSTA = 0b00100100;
+        RCSTA = 0b10000000;
+    }
+    traceSend ('T');
+    traceSend ('R');
+    traceSend (traceCount);
+    record = (traceNext - traceCount) & (traceRecords - 1);
+    while (traceCount)
+    {
+        n = 0;
+        while (n < 4)
+        {
+            traceSend (traceBuffer [record][n]);
+            n ++;
+        }
+        record = (record + 1) & (traceRecords - 1);
+        traceCount --;
+    }
+    traceState = traceRunning;      // Start recording again
+    INTCONbits.GIE = gie;
+}
+
+#else
+
+#define traceEvent(id, arg)
+
+#endif
+
+#endif
@@ -77,11 +77,29 @@
  */
 
 #include <xc.h>
+#include "pins_HHWardBook1.h"
+#include "trace_HHWardBook1.h"    // With TRACE defined each phase change is recorded and sent out of RC6 every cycle
 #define _XTAL_FREQ (8000000)
 
-#define redLamp1 PORTBbits.RB0      
-#define amberLamp1 PORTBbits.RB1    
-#define greenLamp1 PORTBbits.RB2    
+#include "trafficPlan_HHWardBook1.h" // The phase times and trafficOffset, they can be set on the command line
+
+#define redLamp1 B,0
+#define amberLamp1 B,1
+#define greenLamp1 B,2
+#define trafficTick 10      // ms each time round the loop
+#ifdef TRAFFIC_SYNC
+#define syncInput A,0       // A rising edge here, e.g. from the first junction of the road, puts the cycle back to trafficOffset
+#endif
+
+unsigned int position;      // ms since red came on
+unsigned char phase, lastPhase, lamps, lastSync;
+
+#ifdef TRACE
+void __interrupt() isr (void)
+{
+    traceInterrupt ();
+}
+#endif
 
 void main(void) {
     
@@ -95,21 +113,37 @@ ADCON0 = 0;     // Turn off ADC
 ADCON1 = 0x0F;  // Make all bits digital
 OSCCON = 0x74;  // Set OSC to 8Mhz with stable output
 T0CON = 0xC7;   // Set TMR0 to 8 bit register with divide by 256 rate so runs at 7812.5Hz, one tick = 128us
+#ifdef TRACE
+traceSetUp ();
+#endif
+
+position = trafficStartPosition (trafficOffset);
+lastPhase = 0xFF;   // So the lamps are set the first time round
 
 while (1)       // Start of forever loop so micro carries out start of loop only once
 {
-    redLamp1 = 1;
-    __delay_ms (5000);    // Call subroutine 'delay' and passes value 153 up to the subroutine to create 5 second delay
-    amberLamp1 = 1;
-    __delay_ms (2000);     // 2 second delay
-    redLamp1 = 0;
-    amberLamp1 = 0;
-    greenLamp1 = 1;
-    __delay_ms (5000);
-    greenLamp1 = 0;
-    amberLamp1 = 1;
-    __delay_ms (2000);
-    amberLamp1 = 0;
-    
+    phase = trafficPhaseAt (position);
+    if (phase != lastPhase)     // Only touch the lamps when the phase changes
+    {
+        lamps = trafficLamps (phase);
+        pinWrite (redLamp1, (lamps & redLampBit) != 0);
+        pinWrite (amberLamp1, (lamps & amberLampBit) != 0);
+        pinWrite (greenLamp1, (lamps & greenLampBit) != 0);
+        traceEvent (tracePhase, phase);
+        lastPhase = phase;
+    }
+    __delay_ms (trafficTick);   // The loop itself adds a few us each time, the sync pulse takes out the drift
+    position += trafficTick;
+    if (position >= trafficCycle)
+    {
+        position -= trafficCycle;
+#ifdef TRACE
+        traceDump ();
+#endif
+    }
+#ifdef TRAFFIC_SYNC
+    if (pinRead (syncInput) && !lastSync) position = trafficStartPosition (trafficOffset);
+    lastSync = pinRead (syncInput);
+#endif
 }
 }
@@ -0,0 +1,74 @@
+/*
+ * File:   trafficPlan_HHWardBook1.h
+ * Name: The timing plan of the traffic lights
+ *
+ * The cycle is red, red and amber, green, amber, and a position in it is the number of ms
+ * since red came on. trafficLightMain.c works out its lamps from the position and
+ * host/corridor.c uses the same subroutines to run a row of junctions on the PC, so a
+ * plan tried there is the plan the PIC runs.
+ *
+ * trafficOffset moves the cycle along: red comes on trafficOffset ms after the start, and
+ * after every sync pulse if the junction has one. Giving each junction along a road an
+ * offset equal to the driving time from the first one makes a green wave.
+ *
+ *      position        0           redTime         + redAmberTime  + greenTime     cycle
+ *      phase           red         red and amber   green           amber
+ *
+ * Times are in ms and can be set on the command line. The cycle must be under 65536ms.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef TRAFFICPLAN_HHWARDBOOK1_H
+#define TRAFFICPLAN_HHWARDBOOK1_H
+
+#ifndef redTime             // How long each phase lasts in ms
+#define redTime 5000
+#endif
+#ifndef redAmberTime
+#define redAmberTime 2000
+#endif
+#ifndef greenTime
+#define greenTime 5000
+#endif
+#ifndef amberTime
+#define amberTime 2000
+#endif
+#ifndef trafficOffset       // ms from the start or a sync pulse until red comes on
+#define trafficOffset 0
+#endif
+#define trafficCycle ((unsigned int) redTime + redAmberTime + greenTime + amberTime)
+#define redPhase 0
+#define redAmberPhase 1
+#define greenPhase 2
+#define amberPhase 3
+#define redLampBit 0x01             // The lamps that are on in each phase
+#define amberLampBit 0x02
+#define greenLampBit 0x04
+
+const unsigned char trafficLampTable [4] = {redLampBit, redLampBit | amberLampBit, greenLampBit, amberLampBit};
+
+// The subroutines
+
+unsigned char trafficPhaseAt (unsigned int position)    // Which phase a position in the cycle is in
+{
+    if (position < redTime) return redPhase;
+    position -= redTime;
+    if (position < redAmberTime) return redAmberPhase;
+    position -= redAmberTime;
+    if (position < greenTime) return greenPhase;
+    return amberPhase;
+}
+
+unsigned char trafficLamps (unsigned char phase)        // redLampBit, amberLampBit and greenLampBit
+{
+    return trafficLampTable [phase];
+}
+
+unsigned int trafficStartPosition (unsigned int offset) // Where to start so red comes on offset ms later
+{
+    offset %= trafficCycle;
+    return offset ? trafficCycle - offset : 0;
+}
+
+#endif